@@ -31,15 +31,43 @@
 #ifndef MTL_STL_STREAMING_HPP_INCLUDED
 #define MTL_STL_STREAMING_HPP_INCLUDED
 
+#include <algorithm> // For std::sort.
 #include <array>     // For explicit specialization of ostream<<.
+#include <bitset>    // For std::bitset.
+#include <cmath>     // For std::sqrt.
+#include <cstdint>   // For std::uint64_t.
 #include <cstdlib>   // For std::size_t.
+#include <cstring>   // For std::memcpy.
+#include <iterator>  // For std::forward_iterator_tag.
+#include <limits>    // For std::numeric_limits.
+#include <locale>    // For std::num_put.
+#include <memory>    // For std::addressof.
 #include <ostream>   // For std::ostream.
 #include <queue>     // For std::queue creation of begin() && end().
+#include <random>    // For std::mt19937_64.
+#include <sstream>   // For std::ostringstream.
 #include <stack>     // For std::stack creation of begin() && end().
+#include <streambuf> // For std::streambuf.
 #include <stdexcept> // For std::runtime_error.
 #include <string>    // For std::basic_string, wchar_t.
+#if __cplusplus >= 201703L
+#include <string_view> // For std::string_view.
+#endif
 #include <tuple>     // For std::tuple and std::get<> and std::tuple_size<>.
+#include <type_traits> // For std::decay.
+#include <unordered_set> // For the indices picked by mtl::sample().
 #include <utility>   // For std::declval.
+#include <vector>    // For std::vector<T>::iterator.
+
+// mapped_array needs the POSIX headers, which declare open(), read(), close()... in the global namespace, so it is
+// only available if MTL_ENABLE_MMAP is defined before including this file.
+#if defined(MTL_ENABLE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>    // For open().
+#include <sys/mman.h> // For mmap(), madvise() and munmap().
+#include <sys/stat.h> // For fstat().
+#include <unistd.h>   // For close() and sysconf().
+#define MTL_HAS_MMAP //!< mapped_array is only available where mmap() is.
+#endif
 
 
 //! @brief Completely disable creation
@@ -343,328 +371,3895 @@ struct array_cast final
         MTL_UNCREATABLE(array_cast);
 };
 
+#ifdef MTL_HAS_MMAP
+//-----------------------------------------------------------------------------
+/**
+ * @class mapped_array
+ * @brief Maps a binary file read-only and provides begin() and end() to display it as an array of @b T.
+ * The file is never read into memory by yourself, pages are loaded (and dropped) by the kernel while
+ * displaying, so even huge dumps are shown with a constant memory usage.
+ * @tparam T The type of the values stored in the file (T = float for a float dump).
+ */
+template<typename T>
+struct mapped_array final
+{
+    static_assert(std::is_trivially_copyable<T>::value, "mapped_array<> requires a trivially copyable type");
+    private:
+        void*       mapping;
+        std::size_t length;
+        const T*    ptr;
+        std::size_t n;
 
-#define MTL_IS_TUPLE     1u //!< A specific flag for compile time branchement.
-#define MTL_IS_NOT_TUPLE 0u //!< A specific flag for compile time branchement.
+        /**
+         * @brief Maps @b count elements of @b path, starting at @b offset bytes.
+         * @param[in] path   The file to map.
+         * @param[in] offset The offset (in bytes) of the first element.
+         * @param[in] count  The number of elements, or 0 to map everything after @b offset.
+         */
+        void map(const std::string& path, std::size_t offset, std::size_t count)
+        {
+            if (offset % alignof(T) != 0u)
+            {
+                throw std::runtime_error("mapped_array<> with a misaligned offset !");
+            }
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::runtime_error("mapped_array<> can't open " + path + " !");
+            }
+            struct stat infos;
+            if (::fstat(fd, &infos) != 0 || static_cast<std::size_t>(infos.st_size) < offset)
+            {
+                ::close(fd);
+                throw std::runtime_error("mapped_array<> with an offset out of " + path + " !");
+            }
+            std::size_t available = static_cast<std::size_t>(infos.st_size) - offset;
+            if (count == 0u)
+            {
+                if (available % sizeof(T) != 0u)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("mapped_array<> on a file which isn't an array of T !");
+                }
+                count = available / sizeof(T);
+            }
+            else if (count > available / sizeof(T))
+            {
+                ::close(fd);
+                throw std::runtime_error("mapped_array<> with a size bigger than " + path + " !");
+            }
+            if (count == 0u)
+            {
+                ::close(fd);
+                throw std::runtime_error("mapped_array<> with a null size !");
+            }
+            // mmap() wants a page aligned offset, so the mapping may start a bit before the first element.
+            std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            std::size_t base = offset - offset % page;
+            this->length  = offset - base + count*sizeof(T);
+            this->mapping = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(base));
+            ::close(fd);
+            if (this->mapping == MAP_FAILED)
+            {
+                throw std::runtime_error("mapped_array<> can't map " + path + " !");
+            }
+            ::madvise(this->mapping, this->length, MADV_SEQUENTIAL);
+            this->ptr = reinterpret_cast<const T*>(static_cast<const char*>(this->mapping) + (offset - base));
+            this->n   = count;
+        }
+    public:
+        /**
+         * @brief Maps the whole file @b path, after @b offset bytes.
+         * @param[in] path   The binary file you wanna display.
+         * @param[in] offset The offset (in bytes) of the first element, it must be aligned for @b T.
+         * @throw std::runtime_error If @b path couldn't be opened or mapped.
+         * @throw std::runtime_error If @b offset is misaligned or out of the file.
+         * @throw std::runtime_error If the remaining size isn't a multiple of sizeof(T), or is 0.
+         */
+        explicit mapped_array(const std::string& path, std::size_t offset = 0u) :
+            mapping(nullptr), length(0u), ptr(nullptr), n(0u)
+        {
+            this->map(path, offset, 0u);
+        }
 
-namespace mtl_details
-{
-    //-----------------------------------------------------------------------------
-    /**
-     * @class Int
-     * @brief A helper class to choose which overload to call.
-     * Basicaly, this class holds an uint for me.
-     * @warning You shall not use this class by yourself.
-     */
-    template<std::size_t N> struct Int final {};
+        /**
+         * @brief Maps @b size elements of the file @b path, after @b offset bytes.
+         * @param[in] path   The binary file you wanna display.
+         * @param[in] offset The offset (in bytes) of the first element, it must be aligned for @b T.
+         * @param[in] size   The number of elements to display.
+         * @throw std::runtime_error If @b path couldn't be opened or mapped.
+         * @throw std::runtime_error If @b offset is misaligned or out of the file.
+         * @throw std::runtime_error If @b size is 0 or goes beyond the end of the file.
+         */
+        mapped_array(const std::string& path, std::size_t offset, std::size_t size) :
+            mapping(nullptr), length(0u), ptr(nullptr), n(0u)
+        {
+            if (size == 0u)
+            {
+                throw std::runtime_error("mapped_array<> with a null size !");
+            }
+            this->map(path, offset, size);
+        }
 
-    //-----------------------------------------------------------------------------
+        //! @{
+        /**
+         * @brief Implements the <b>iterator-pair idiom</b> for <b>mapped_array</b> helper class.
+         * The mapping is read-only, so only const pointers are provided.
+         * @param[in] p The mapped_array helper you want the begin/end iterator.
+         * @return The desired iterator.
+         *
+         * Usage :
+         * @code
+         * mapped_array<float> dump("positions.bin");
+         * std::cout << dump << std::endl;
+         * @endcode
+         */
+        friend const T* begin(const mapped_array<T>& p)
+        {
+            return p.ptr;
+        }
+        friend const T* end(const mapped_array<T>& p)
+        {
+            return p.ptr + p.n;
+        }
+        //! @}
+        ~mapped_array(void)
+        {
+            ::munmap(this->mapping, this->length);
+        }
+        MTL_UNCREATABLE(mapped_array);
+};
+#endif
+
+
+namespace mtl
+{
     //! @{
-    /**
-     * @class is_not_char
-     * @brief This class helps to avoid ambiguity with already implemented operator<< for char/unsigned char arrays.
-     * By using SFINAE idiom, any instanciation with char or unsigned char as specialization reach an error, so
-     * my overload for arrays won't be elected as the valid overload to call.
-     * @warning You shall not use this class by yourself.
-     */
-    template<typename T> struct is_not_char final {};
-    template<> struct is_not_char<char>;
-    template<> struct is_not_char<unsigned char>;
-    template<> struct is_not_char<signed char>; // signed char != char
-    template<> struct is_not_char<wchar_t>;
+    //! @brief The views, declared here so they are stored by value when viewed by an other view.
+    template<typename Container, typename Function> class project_view;
+    template<typename Container, typename Predicate> class filter_view;
+    template<typename Container> class every_view;
+    template<typename Container> class sample_view;
     //! @}
+}
 
+namespace mtl_details
+{
     //-----------------------------------------------------------------------------
+    //! @{
     /**
-     * @brief Valid case of SFINAE idiom, @b T could be use as a std::tuple.
-     * auto keyword allows to use a trailing type declaration (->).@n
-     * If anything with this declaration fails (error, impossibility, etc), this function won't be
-     * elected for this call.@n
-     * Here, if @b T doesn't match the calls of std::tuple_size and std::get, it fails.@n
-     * std::size_t defines the real return type for this function.
-     * @tparam T The type you wanna test.
-     * @return A constexpr MTL_IS_TUPLE, which could be use within compilation context.
-     * @warning You shall not use this function by yourself.
+     * @class is_view
+     * @brief Sets @b value to 1 if @b T is one of the views of mtl, 0 otherwise.
+     * @tparam T The type you wanna check.
+     * @warning You shall not use this class by yourself.
      */
     template<typename T>
-    constexpr auto is_tuple(int) -> decltype(std::ignore = std::tuple_size<T>::value,
-                                             std::ignore = std::get<0>(std::declval<T>()),
-                                             std::size_t())
+    struct is_view final
     {
-        return MTL_IS_TUPLE;
-    }
-
-    //-----------------------------------------------------------------------------
-    /**
-     * @brief Invalid case of SFINAE idiom, @b T couldn't be use as a std::tuple.
-     * Here, the ellipsis defines the very last overload possible to be call. It means that the
-     * above overload will be try first (and this one only if this first overload fails).@n
-     * We could define ellipsis as the ultimate variable black hole.
-     * @tparam T The type you wanna test.
-     * @return A constexpr MTL_IS_NOT_TUPLE, which could be use within compilation context.
-     * @warning You shall not use this function by yourself.
-     */
-    template<typename T>
-    constexpr std::size_t is_tuple(...)
+        MTL_UNCREATABLE(is_view);
+        enum : std::size_t {value = 0u};
+    };
+    template<typename Container, typename Function>
+    struct is_view<::mtl::project_view<Container, Function>> final
     {
-        return MTL_IS_NOT_TUPLE;
-    }
+        MTL_UNCREATABLE(is_view);
+        enum : std::size_t {value = 1u};
+    };
+    template<typename Container, typename Predicate>
+    struct is_view<::mtl::filter_view<Container, Predicate>> final
+    {
+        MTL_UNCREATABLE(is_view);
+        enum : std::size_t {value = 1u};
+    };
+    template<typename Container>
+    struct is_view<::mtl::every_view<Container>> final
+    {
+        MTL_UNCREATABLE(is_view);
+        enum : std::size_t {value = 1u};
+    };
+    template<typename Container>
+    struct is_view<::mtl::sample_view<Container>> final
+    {
+        MTL_UNCREATABLE(is_view);
+        enum : std::size_t {value = 1u};
+    };
+    //! @}
 
     //-----------------------------------------------------------------------------
     /**
-     * @brief The terminal case of tuple recursion (shows last element).
-     * @tparam T Any kind of @b std::tuple.
-     * @param[in,out]  out   The output stream you wanna use.
-     * @param[in]      tuple The @b std::tuple you wanna display.
-     * @param[useless] Isn't use at all, just here to handle the current element number.
-     * warning You shall not use this function by yourself.
+     * @class view_storage
+     * @brief How a view holds what it displays : a pointer on a container, which must outlive the view.
+     * @tparam Container The viewed container.
+     * @warning You shall not use this class by yourself.
      */
-    template<typename T>
-    void tuple_print_rec(std::ostream& out, const T& tuple, ::mtl_details::Int<MTL_IS_TUPLE>)
+    template<typename Container, bool View = ::mtl_details::is_view<Container>::value != 0u>
+    class view_storage final
     {
-        out << std::get<std::tuple_size<T>::value-1>(tuple);
-    }
+        private:
+            const Container* container;
+        public:
+            explicit view_storage(const Container& c) : container(&c)
+            {
+            }
+            //! @return The viewed container.
+            const Container& get(void) const
+            {
+                return *this->container;
+            }
+    };
+    //! @brief An other view is usually a temporary (mtl::filter(mtl::keys(m), p)), so it is copied.
+    template<typename Container>
+    class view_storage<Container, true> final
+    {
+        private:
+            Container view;
+        public:
+            explicit view_storage(const Container& c) : view(c)
+            {
+            }
+            //! @return The copy of the viewed view.
+            const Container& get(void) const
+            {
+                return this->view;
+            }
+    };
 
     //-----------------------------------------------------------------------------
     /**
-     * @brief The general case of tuple recursion (shows current element).
-     * @tparam T Any kind of @b std::tuple.
-     * @tparam NThe number of element left to display.
-     * @param[in,out]  out   The output stream you wanna use.
-     * @param[in]      tuple The @b std::tuple you wanna display.
-     * @param[useless] Isn't use at all, just here to handle the current element number.
-     * @warning You shall not use this function by yourself.
+     * @class iterator_of
+     * @brief Defines @b type as the iterator returned by begin() on a const @b Container.
+     * @tparam Container The container you wanna iterate through.
+     * @warning You shall not use this class by yourself.
      */
-    template<typename T, std::size_t N>
-    void tuple_print_rec(std::ostream& out, const T& tuple, ::mtl_details::Int<N>)
+    template<typename Container>
+    struct iterator_of final
     {
-        out << std::get<std::tuple_size<T>::value - N>(tuple) << ' ';
-        ::mtl_details::tuple_print_rec(out, tuple, ::mtl_details::Int<N-1>());
-    }
+        typedef decltype(begin(std::declval<const Container&>())) type; //!< The const iterator.
+        MTL_UNCREATABLE(iterator_of);
+    };
 
     //-----------------------------------------------------------------------------
     /**
-     * @brief Prints a container which match the std::tuple interface.
-     * @tparam Container The container you wanna display.
-     * @param[in,out]  out       The output stream you wanna use.
-     * @param[in]      container The container you wanna display.
-     * @param[useless]           Isn't use at all, just here to select this function.
-     * @warning You shall not use this function by yourself.
+     * @class get_key
+     * @brief Returns a reference on the first element of a pair (the key of a map entry).
+     * @warning You shall not use this class by yourself.
      */
-    template<typename Container>
-    std::ostream& print(std::ostream& out, const Container& container, ::mtl_details::Int<MTL_IS_NOT_TUPLE>)
+    struct get_key final
     {
-        out << "[ ";
-        auto iterator_end = end(container);
-        for(auto it=begin(container);it!=iterator_end;++it)
+        template<typename Pair>
+        auto operator()(const Pair& pair) const -> decltype(std::get<0>(pair))
         {
-            out << *it << ' ';
+            return std::get<0>(pair);
         }
-        return out << ']';
-    }
+    };
 
     //-----------------------------------------------------------------------------
     /**
-     * @brief Prints a container which doesn't the std::tuple interface.
-     * @tparam Container The container you wanna display.
-     * @param[in,out]  out       The output stream you wanna use.
-     * @param[in]      container The container you wanna display.
-     * @param[useless]           Isn't use at all, just here to select this function.
-     * @warning You shall not use this function by yourself.
+     * @class get_value
+     * @brief Returns a reference on the second element of a pair (the value of a map entry).
+     * @warning You shall not use this class by yourself.
      */
-    template<typename Container>
-    std::ostream& print(std::ostream& out, const Container& container, ::mtl_details::Int<MTL_IS_TUPLE>)
+    struct get_value final
     {
-        out << "( ";
-        ::mtl_details::tuple_print_rec(out, container,
-                                       ::mtl_details::Int<std::tuple_size<Container>::value>());
-        return out << " )";
-    }
+        template<typename Pair>
+        auto operator()(const Pair& pair) const -> decltype(std::get<1>(pair))
+        {
+            return std::get<1>(pair);
+        }
+    };
 
     //-----------------------------------------------------------------------------
     /**
-     * @class is_tuplable
-     * @brief A wrapper to check with SFINAE if @b T matches std::tuple interface.
-     * @tparam T The type you wanna test.
+     * @class member_projection
+     * @brief Returns a reference on a data member of @b Class, so nothing is copied.
+     * @tparam Class  The type which holds the member.
+     * @tparam Member The type of the member.
      * @warning You shall not use this class by yourself.
      */
-    template<typename T>
-    struct is_tuplable final
+    template<typename Class, typename Member>
+    struct member_projection final
     {
-        enum : std::size_t {value = ::mtl_details::is_tuple<T>(0)};
-        MTL_UNCREATABLE(is_tuplable);
+        Member Class::* member; //!< The projected data member.
+
+        const Member& operator()(const Class& object) const
+        {
+            return object.*member;
+        }
     };
 
     //-----------------------------------------------------------------------------
     /**
-     * @class enable_if_not_same
-     * @brief Defines @b type if and only if C1 != C2. Implicitly, this allows to use SFINAE
-     * to exclude different kind of "containers".
-     * @tparam C1 A random type which accepts multiple template parameters.
-     * @tparam C2 A random type which accepts multiple template parameters.
-     * @warning You shall not use this function by yourself.
+     * @class multi_pass
+     * @brief Sets @b value to true if a range could be walked through several times with copies of @b Iterator,
+     * which is false for single pass (input) iterators such as std::istream_iterator.
+     * @tparam Iterator The iterator you wanna test.
+     * @warning You shall not use this class by yourself.
      */
-    template<template<typename...> class C1, template<typename...> class C2>
-    struct enable_if_not_same final
+    template<typename Iterator>
+    struct multi_pass final
     {
-        MTL_UNCREATABLE(enable_if_not_same);
-        typedef int type; //!< Provides a type, this is it.
+        enum : std::size_t
+        {
+            value = std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>::value
+        };
+        //! The category of an iterator walking through @b Iterator, it is a forward one at best.
+        typedef typename std::conditional<value, std::forward_iterator_tag, std::input_iterator_tag>::type category;
+        MTL_UNCREATABLE(multi_pass);
     };
-    //! @brief No such implementation, it will fail overload selection.
-    template<template<typename...> class C1>
-    struct enable_if_not_same<C1, C1>;
 
     //-----------------------------------------------------------------------------
     /**
-     * @class has_iterators
-     * @brief Set @b value to true if @b T has iterators, @b false otherwise.
-     * @tparam T The type you wanna check for iterators.
-     * @warning You shall not use this function by yourself.
+     * @class projection_iterator
+     * @brief Forward iterator which applies @b Function on each dereferenced element.
+     * @tparam Iterator The underlying iterator.
+     * @tparam Function The projection to apply, which is owned by the view.
+     * @warning You shall not use this class by yourself.
      */
-    template<typename T>
-    struct has_iterators final
+    template<typename Iterator, typename Function>
+    class projection_iterator final
     {
         private:
-            /**
-             * @brief Ensure than C has basic iterator idiom (begin && end).
-             * @return true
-             */
-            template<typename C, typename b = decltype(begin(std::declval<C>())),
-                                 typename e = decltype(end(std::declval<C>()))>
-            static constexpr bool check(int)
+            Iterator        current;
+            const Function* function;
+        public:
+            typedef decltype(std::declval<const Function&>()(*std::declval<Iterator>())) reference;
+            typedef typename std::decay<reference>::type value_type;
+            typedef const value_type*                    pointer;
+            typedef std::ptrdiff_t                       difference_type;
+            typedef typename ::mtl_details::multi_pass<Iterator>::category iterator_category;
+
+            projection_iterator(void) : current(), function(nullptr)
             {
-                return true;
             }
-            /**
-             * @brief C doesn't implement iterator idiom.
-             * @return false
-             */
-            template<typename C>
-            static constexpr bool check(...)
+            projection_iterator(Iterator it, const Function* f) : current(it), function(f)
             {
-                return false;
             }
-        public:
-            MTL_UNCREATABLE(has_iterators);
-            enum {value = has_iterators<T>::check<T>(0)};
-    };
-
-    //-----------------------------------------------------------------------------
+            reference operator*(void) const
+            {
+                return (*function)(*current);
+            }
+            //! @return The underlying iterator.
+            const Iterator& base(void) const
+            {
+                return current;
+            }
+            projection_iterator& operator++(void)
+            {
+                ++current;
+                return *this;
+            }
+            bool operator==(const projection_iterator& other) const
+            {
+                return current == other.current;
+            }
+            bool operator!=(const projection_iterator& other) const
+            {
+                return current != other.current;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
     /**
-     * @class grant_access
-     * @brief  Defines @b granted type if and only if the boolean template parameter is @b true.
-     * @tparam B The boolean value pre calculated.
-     * @warning You shall not use this function by yourself.
+     * @class filter_iterator
+     * @brief Forward iterator which skips every element not matching @b Predicate.
+     * @tparam Iterator  The underlying iterator.
+     * @tparam Predicate The filter to apply, which is owned by the view.
+     * @warning You shall not use this class by yourself.
      */
-    template<bool B> struct grant_access;
-    //! Valid case, it grants access.
-    template<> struct grant_access<true> final
+    template<typename Iterator, typename Predicate>
+    class filter_iterator final
     {
-        MTL_UNCREATABLE(grant_access);
-        typedef int granted; //!< This type exists, so SFINAE doesn't fail.
+        private:
+            Iterator         current;
+            Iterator         last;
+            const Predicate* predicate;
+
+            void skip(void)
+            {
+                while(current != last && !(*predicate)(*current))
+                {
+                    ++current;
+                }
+            }
+        public:
+            typedef decltype(*std::declval<Iterator>())  reference;
+            typedef typename std::decay<reference>::type value_type;
+            typedef const value_type*                    pointer;
+            typedef std::ptrdiff_t                       difference_type;
+            typedef typename ::mtl_details::multi_pass<Iterator>::category iterator_category;
+
+            filter_iterator(void) : current(), last(), predicate(nullptr)
+            {
+            }
+            filter_iterator(Iterator it, Iterator end, const Predicate* p) : current(it), last(end), predicate(p)
+            {
+                this->skip();
+            }
+            reference operator*(void) const
+            {
+                return *current;
+            }
+            filter_iterator& operator++(void)
+            {
+                ++current;
+                this->skip();
+                return *this;
+            }
+            bool operator==(const filter_iterator& other) const
+            {
+                return current == other.current;
+            }
+            bool operator!=(const filter_iterator& other) const
+            {
+                return current != other.current;
+            }
     };
 }
 
-//-----------------------------------------------------------------------------
-/**
- * @brief Defines an overload for C-style arrays, but not for char and unsigned char arrays.
- * Because it conflicts with current implementation of the STL.
- * @tparam ArrayType The type of your array.
- * @tparam N         The number of element of this array.
- * @param[in,out] out   The output stream you wanna use.
- * @param[in]     array The C-style array you wanna display.
- *
- * The trailing return type (auto and ->) ensures than ArrayType isn't char or unsigned char.@n
- * (out) ensures than we create a std::ostream& as return type.@n
- * Anyway, you could use it simply :
- * @code
- * int zeInts[8] = {1, 2, 3, 4, 5, 6, 7, 8};
- * std::cout << zeInts << std::endl;
- * // Output : [ 1 2 3 4 5 6 7 8 ]
- * @endcode
- * @return @b out as std::ostream& (I sware it does).
- */
-template<typename ArrayType, std::size_t N>
-auto operator<<(std::ostream& out, const ArrayType (&array)[N])
-    -> decltype(::mtl_details::is_not_char<ArrayType>(), (out))
+namespace mtl
 {
-    return ::mtl_details::print(out, array, ::mtl_details::Int<MTL_IS_NOT_TUPLE>());
-}
+    //-----------------------------------------------------------------------------
+    /**
+     * @class project_view
+     * @brief A non owning view which displays @b Function applied on each element of @b Container.
+     * Nothing is allocated nor copied, the view only holds a pointer on the container (or a copy of it, when it
+     * is an other view).
+     * @tparam Container The container you wanna display.
+     * @tparam Function  The projection, called with each element.
+     * @warning The container must outlive the view.
+     */
+    template<typename Container, typename Function>
+    class project_view final
+    {
+        private:
+            ::mtl_details::view_storage<Container> container;
+            Function                               function;
+        public:
+            //! @brief The iterator type returned by begin() and end().
+            typedef ::mtl_details::projection_iterator<
+                typename ::mtl_details::iterator_of<Container>::type, Function> iterator;
 
-//-----------------------------------------------------------------------------
-/**
- * @brief Defines an overload for std::array.
- * @tparam ArrayType The type of your array.
- * @tparam N         The number of element of this array.
- * @param[in,out] output The output stream you wanna use.
- * @param[in]     array  The std::array array you wanna display.
- *
- * You could use it simply :
- * @code
- * std::array<int, 8> array;
- * // Fill it with 1 2 3 4 5 6 7 8
- * std::cout << array << std::endl;
- * // Output : ( 1 2 3 4 5 6 7 8 )
- * @endcode
- * @return @b output
- */
-template<typename T, std::size_t S>
-std::ostream& operator<<(std::ostream& output, const std::array<T, S>& array)
-{
-    return ::mtl_details::print(output, array, ::mtl_details::Int<MTL_IS_TUPLE>());
+            /**
+             * @brief Creates a view on @b c.
+             * @param[in] c The viewed container.
+             * @param[in] f The projection.
+             */
+            project_view(const Container& c, Function f) : container(c), function(f)
+            {
+            }
+
+            //! @{
+            //! @brief Implements the <b>iterator-pair idiom</b> for <b>project_view</b>.
+            friend iterator begin(const project_view& view)
+            {
+                return iterator(begin(view.container.get()), &view.function);
+            }
+            friend iterator end(const project_view& view)
+            {
+                return iterator(end(view.container.get()), &view.function);
+            }
+            //! @}
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class filter_view
+     * @brief A non owning view which displays the elements of @b Container matching @b Predicate.
+     * @tparam Container The container you wanna display.
+     * @tparam Predicate The filter, called with each element.
+     * @warning The container must outlive the view.
+     */
+    template<typename Container, typename Predicate>
+    class filter_view final
+    {
+        private:
+            ::mtl_details::view_storage<Container> container;
+            Predicate                              predicate;
+        public:
+            //! @brief The iterator type returned by begin() and end().
+            typedef ::mtl_details::filter_iterator<
+                typename ::mtl_details::iterator_of<Container>::type, Predicate> iterator;
+
+            /**
+             * @brief Creates a view on @b c.
+             * @param[in] c The viewed container.
+             * @param[in] p The filter.
+             */
+            filter_view(const Container& c, Predicate p) : container(c), predicate(p)
+            {
+            }
+
+            //! @{
+            //! @brief Implements the <b>iterator-pair idiom</b> for <b>filter_view</b>.
+            friend iterator begin(const filter_view& view)
+            {
+                return iterator(begin(view.container.get()), end(view.container.get()), &view.predicate);
+            }
+            friend iterator end(const filter_view& view)
+            {
+                return iterator(end(view.container.get()), end(view.container.get()), &view.predicate);
+            }
+            //! @}
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b f applied on each element of @b c, without building any temporary.
+     * @param[in] c The container you wanna display.
+     * @param[in] f Any callable taking an element of @b c.
+     * @return The view, which could be sent to a std::ostream.
+     *
+     * Usage :
+     * @code
+     * std::vector<int> v = {1, 2, 3};
+     * std::cout << mtl::project(v, [](int i){return i*i;}) << std::endl;
+     * // Output : [ 1 4 9 ]
+     * @endcode
+     */
+    template<typename Container, typename Function>
+    project_view<Container, Function> project(const Container& c, Function f)
+    {
+        return project_view<Container, Function>(c, f);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays a data member of each element of @b c.
+     * The member is accessed by reference, so it isn't copied either.
+     * @param[in] c      The container you wanna display.
+     * @param[in] member A pointer on the data member (such as &Point::x).
+     * @return The view, which could be sent to a std::ostream.
+     */
+    template<typename Container, typename Class, typename Member>
+    auto project(const Container& c, Member Class::* member)
+        -> decltype(std::ignore = typename std::enable_if<std::is_member_object_pointer<Member Class::*>::value, int>::type{},
+                    project_view<Container, ::mtl_details::member_projection<Class, Member>>(
+                        c, ::mtl_details::member_projection<Class, Member>{member}))
+    {
+        return project_view<Container, ::mtl_details::member_projection<Class, Member>>(
+            c, ::mtl_details::member_projection<Class, Member>{member});
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays the keys of an associative container (or any range of pairs).
+     * @param[in] c The container you wanna display.
+     * @return The view, which could be sent to a std::ostream.
+     */
+    template<typename Container>
+    project_view<Container, ::mtl_details::get_key> keys(const Container& c)
+    {
+        return project_view<Container, ::mtl_details::get_key>(c, ::mtl_details::get_key());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays the values of an associative container (or any range of pairs).
+     * @param[in] c The container you wanna display.
+     * @return The view, which could be sent to a std::ostream.
+     */
+    template<typename Container>
+    project_view<Container, ::mtl_details::get_value> values(const Container& c)
+    {
+        return project_view<Container, ::mtl_details::get_value>(c, ::mtl_details::get_value());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays the elements of @b c for which @b p returns true.
+     * @param[in] c The container you wanna display.
+     * @param[in] p Any callable taking an element of @b c and returning a bool.
+     * @return The view, which could be sent to a std::ostream.
+     */
+    template<typename Container, typename Predicate>
+    filter_view<Container, Predicate> filter(const Container& c, Predicate p)
+    {
+        return filter_view<Container, Predicate>(c, p);
+    }
 }
 
-//-----------------------------------------------------------------------------
-/**
- * @brief Defines an overload for most of STL containers (except std::array).
- * @tparam Container A type which accept multiple template arguments.
- * @tparam Values    Every @b Container template argument types.
- * @param[in,out] output The output stream you wanna use.
- * @param[in]     c      The STL container you wanna display.
- *
- * It works on :
- *   - std::vector
- *   - std::list
- *   - std::forward_list
- *   - std::deque
- *   - std::queue
- *   - std::stack
- *   - std::set
- *   - std::unordered_set
- *   - std::map
- *   - std::unordered_map
- *   - std::valarray
- *   - std::pair
- *   - std::tuple
- *   - std::priority_queue
- *   - std::multiset
- *   - std::unordered_multiset
- *   - std::multimap
- *   - std::unordered_multimap
- *
- * It is simply to use either :
- * @code
- * // Create any container as cont;
- * // Fill it
- * std::cout << cont << std::endl;
- * @endcode
- * @return @b output
- */
-template<template<typename...> class Container, typename... Types>
-auto operator<<(std::ostream& output, const Container<Types...>& c)
-    -> decltype(std::ignore = typename mtl_details::enable_if_not_same<std::basic_string, Container>::type{},
-                std::ignore = typename mtl_details::grant_access<
-                    mtl_details::has_iterators<Container<Types...>>::value ||
-                    mtl_details::is_tuplable<Container<Types...>>::value>::granted{},
-                (output))
+
+#define MTL_IS_TUPLE     1u //!< A specific flag for compile time branchement.
+#define MTL_IS_NOT_TUPLE 0u //!< A specific flag for compile time branchement.
+
+#ifndef MTL_SMALL_TUPLE_MAX
+//! @brief Tuples and std::array up to this size are formatted into a stack buffer, then written at once.
+#define MTL_SMALL_TUPLE_MAX 16u
+#endif
+
+#ifndef MTL_PREFETCH_DISTANCE
+//! @brief How many nodes ahead are prefetched while displaying node based containers.
+#define MTL_PREFETCH_DISTANCE 4u
+#endif
+
+#ifndef MTL_FORMAT_ARENA_MIN
+//! @brief The initial size of the per thread buffer of mtl::to_string_view(), it never shrinks below.
+#define MTL_FORMAT_ARENA_MIN 256u
+#endif
+
+#ifndef MTL_FORMAT_ARENA_IDLE
+//! @brief After this many calls using less than a quarter of it, the per thread buffer is shrunk.
+#define MTL_FORMAT_ARENA_IDLE 64u
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MTL_PREFETCH(address) __builtin_prefetch(address) //!< Hints the CPU to load @b address.
+#else
+#define MTL_PREFETCH(address) ((void)(address))
+#endif
+
+namespace mtl_details
 {
-    typedef typename std::decay<decltype(c)>::type RawType;
-    constexpr std::size_t N = ::mtl_details::is_tuplable<RawType>::value;
-    return ::mtl_details::print(output, c, ::mtl_details::Int<N>());
+    //-----------------------------------------------------------------------------
+    /**
+     * @class Int
+     * @brief A helper class to choose which overload to call.
+     * Basicaly, this class holds an uint for me.
+     * @warning You shall not use this class by yourself.
+     */
+    template<std::size_t N> struct Int final {};
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class is_not_char
+     * @brief This class helps to avoid ambiguity with already implemented operator<< for char/unsigned char arrays.
+     * By using SFINAE idiom, any instanciation with char or unsigned char as specialization reach an error, so
+     * my overload for arrays won't be elected as the valid overload to call.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T> struct is_not_char final {};
+    template<> struct is_not_char<char>;
+    template<> struct is_not_char<unsigned char>;
+    template<> struct is_not_char<signed char>; // signed char != char
+    template<> struct is_not_char<wchar_t>;
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Valid case of SFINAE idiom, @b T could be use as a std::tuple.
+     * auto keyword allows to use a trailing type declaration (->).@n
+     * If anything with this declaration fails (error, impossibility, etc), this function won't be
+     * elected for this call.@n
+     * Here, if @b T doesn't match the calls of std::tuple_size and std::get, it fails.@n
+     * std::size_t defines the real return type for this function.
+     * @tparam T The type you wanna test.
+     * @return A constexpr MTL_IS_TUPLE, which could be use within compilation context.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    constexpr auto is_tuple(int) -> decltype(std::ignore = std::tuple_size<T>::value,
+                                             std::ignore = std::get<0>(std::declval<T>()),
+                                             std::size_t())
+    {
+        return MTL_IS_TUPLE;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Invalid case of SFINAE idiom, @b T couldn't be use as a std::tuple.
+     * Here, the ellipsis defines the very last overload possible to be call. It means that the
+     * above overload will be try first (and this one only if this first overload fails).@n
+     * We could define ellipsis as the ultimate variable black hole.
+     * @tparam T The type you wanna test.
+     * @return A constexpr MTL_IS_NOT_TUPLE, which could be use within compilation context.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    constexpr std::size_t is_tuple(...)
+    {
+        return MTL_IS_NOT_TUPLE;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class is_tuplable
+     * @brief A wrapper to check with SFINAE if @b T matches std::tuple interface.
+     * @tparam T The type you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    struct is_tuplable final
+    {
+        enum : std::size_t {value = ::mtl_details::is_tuple<T>(0)};
+        MTL_UNCREATABLE(is_tuplable);
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class enable_if_not_same
+     * @brief Defines @b type if and only if C1 != C2. Implicitly, this allows to use SFINAE
+     * to exclude different kind of "containers".
+     * @tparam C1 A random type which accepts multiple template parameters.
+     * @tparam C2 A random type which accepts multiple template parameters.
+     * @warning You shall not use this function by yourself.
+     */
+    template<template<typename...> class C1, template<typename...> class C2>
+    struct enable_if_not_same final
+    {
+        MTL_UNCREATABLE(enable_if_not_same);
+        typedef int type; //!< Provides a type, this is it.
+    };
+    //! @brief No such implementation, it will fail overload selection.
+    template<template<typename...> class C1>
+    struct enable_if_not_same<C1, C1>;
+#if __cplusplus >= 201703L
+    //! @brief std::basic_string_view already has its operator<<, just like std::basic_string.
+    template<>
+    struct enable_if_not_same<std::basic_string, std::basic_string_view>;
+#endif
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class has_iterators
+     * @brief Set @b value to true if @b T has iterators, @b false otherwise.
+     * @tparam T The type you wanna check for iterators.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    struct has_iterators final
+    {
+        private:
+            /**
+             * @brief Ensure than C has basic iterator idiom (begin && end).
+             * @return true
+             */
+            template<typename C, typename b = decltype(begin(std::declval<C>())),
+                                 typename e = decltype(end(std::declval<C>()))>
+            static constexpr bool check(int)
+            {
+                return true;
+            }
+            /**
+             * @brief C doesn't implement iterator idiom.
+             * @return false
+             */
+            template<typename C>
+            static constexpr bool check(...)
+            {
+                return false;
+            }
+        public:
+            MTL_UNCREATABLE(has_iterators);
+            enum {value = has_iterators<T>::check<T>(0)};
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class grant_access
+     * @brief  Defines @b granted type if and only if the boolean template parameter is @b true.
+     * @tparam B The boolean value pre calculated.
+     * @warning You shall not use this function by yourself.
+     */
+    template<bool B> struct grant_access;
+    //! Valid case, it grants access.
+    template<> struct grant_access<true> final
+    {
+        MTL_UNCREATABLE(grant_access);
+        typedef int granted; //!< This type exists, so SFINAE doesn't fail.
+    };
+}
+
+//-----------------------------------------------------------------------------
+//! @{
+/**
+ * @brief Declarations of the overloads defined below.
+ * They must be visible before the printing helpers, so nested elements (such as the std::pair
+ * of a std::map) find them too.
+ */
+template<typename ArrayType, std::size_t N>
+auto operator<<(std::ostream& out, const ArrayType (&array)[N])
+    -> decltype(::mtl_details::is_not_char<ArrayType>(), (out));
+
+template<typename T, std::size_t S>
+std::ostream& operator<<(std::ostream& output, const std::array<T, S>& array);
+
+template<template<typename...> class Container, typename... Types>
+auto operator<<(std::ostream& output, const Container<Types...>& c)
+    -> decltype(std::ignore = typename mtl_details::enable_if_not_same<std::basic_string, Container>::type{},
+                std::ignore = typename mtl_details::grant_access<
+                    mtl_details::has_iterators<Container<Types...>>::value ||
+                    mtl_details::is_tuplable<Container<Types...>>::value>::granted{},
+                (output));
+//! @}
+
+namespace mtl_details
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class indexed
+     * @brief An element annotated with its position in its container, displayed as #index:element.
+     * @tparam Reference The type of the element (usually a const reference).
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Reference>
+    struct indexed final
+    {
+        std::size_t index;   //!< The position of the element.
+        Reference   element; //!< The element.
+
+        /**
+         * @brief Displays #index:element, the index is always in decimal.
+         * @param[in,out] out   The output stream you wanna use.
+         * @param[in]     value The element to display.
+         * @return @b out
+         */
+        friend std::ostream& operator<<(std::ostream& out, const indexed& value)
+        {
+            char buffer[std::numeric_limits<std::size_t>::digits10 + 3u];
+            char* cursor = buffer + sizeof(buffer);
+            std::size_t index = value.index;
+            *--cursor = ':';
+            do
+            {
+                *--cursor = static_cast<char>('0' + index % 10u);
+                index /= 10u;
+            } while(index != 0u);
+            *--cursor = '#';
+            out.write(cursor, buffer + sizeof(buffer) - cursor);
+            return out << value.element;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @brief Moves @b it forward by @b n elements, without going beyond @b last.
+     * @param[in,out]  it   The iterator to move.
+     * @param[in]      last The end of the range.
+     * @param[in]      n    The number of steps.
+     * @param[useless]      The iterator category, to jump directly with random access iterators.
+     * @return The number of steps really done.
+     * @warning You shall not use these functions by yourself.
+     */
+    template<typename Iterator>
+    std::size_t bounded_advance(Iterator& it, const Iterator& last, std::size_t n, std::random_access_iterator_tag)
+    {
+        std::size_t left = static_cast<std::size_t>(last - it);
+        std::size_t steps = n < left ? n : left;
+        it += static_cast<typename std::iterator_traits<Iterator>::difference_type>(steps);
+        return steps;
+    }
+    template<typename Iterator>
+    std::size_t bounded_advance(Iterator& it, const Iterator& last, std::size_t n, std::forward_iterator_tag)
+    {
+        std::size_t steps = 0u;
+        for(;steps < n && it != last;++steps)
+        {
+            ++it;
+        }
+        return steps;
+    }
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class stride_iterator
+     * @brief Forward iterator which visits one element out of @b stride, annotated with its index.
+     * @tparam Iterator The underlying iterator.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Iterator>
+    class stride_iterator final
+    {
+        private:
+            Iterator    current;
+            Iterator    last;
+            std::size_t index;
+            std::size_t stride;
+        public:
+            typedef ::mtl_details::indexed<decltype(*std::declval<Iterator>())> value_type;
+            typedef value_type                                                  reference;
+            typedef const value_type*                                           pointer;
+            typedef std::ptrdiff_t                                              difference_type;
+            typedef typename ::mtl_details::multi_pass<Iterator>::category      iterator_category;
+
+            stride_iterator(void) : current(), last(), index(0u), stride(1u)
+            {
+            }
+            stride_iterator(Iterator it, Iterator end, std::size_t step) : current(it), last(end), index(0u),
+                stride(step)
+            {
+            }
+            reference operator*(void) const
+            {
+                return value_type{this->index, *this->current};
+            }
+            stride_iterator& operator++(void)
+            {
+                this->index += ::mtl_details::bounded_advance(this->current, this->last, this->stride,
+                    typename std::iterator_traits<Iterator>::iterator_category());
+                return *this;
+            }
+            bool operator==(const stride_iterator& other) const
+            {
+                return this->current == other.current;
+            }
+            bool operator!=(const stride_iterator& other) const
+            {
+                return this->current != other.current;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class sample_iterator
+     * @brief Forward iterator which visits the elements at the indices picked by mtl::sample().
+     * @tparam Iterator The underlying iterator.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Iterator>
+    class sample_iterator final
+    {
+        private:
+            Iterator           current;
+            Iterator           last;
+            const std::size_t* index;    // The next picked index, sorted in increasing order.
+            const std::size_t* indices_end;
+            std::size_t        position; // The index of current.
+
+            void seek(void)
+            {
+                if (this->index != this->indices_end)
+                {
+                    ::mtl_details::bounded_advance(this->current, this->last, *this->index - this->position,
+                        typename std::iterator_traits<Iterator>::iterator_category());
+                    this->position = *this->index;
+                }
+            }
+        public:
+            typedef ::mtl_details::indexed<decltype(*std::declval<Iterator>())> value_type;
+            typedef value_type                                                  reference;
+            typedef const value_type*                                           pointer;
+            typedef std::ptrdiff_t                                              difference_type;
+            typedef typename ::mtl_details::multi_pass<Iterator>::category      iterator_category;
+
+            sample_iterator(void) : current(), last(), index(nullptr), indices_end(nullptr), position(0u)
+            {
+            }
+            sample_iterator(Iterator first, Iterator end, const std::size_t* picked, const std::size_t* picked_end) :
+                current(first), last(end), index(picked), indices_end(picked_end), position(0u)
+            {
+                this->seek();
+            }
+            reference operator*(void) const
+            {
+                return value_type{this->position, *this->current};
+            }
+            sample_iterator& operator++(void)
+            {
+                ++this->index;
+                this->seek();
+                return *this;
+            }
+            bool operator==(const sample_iterator& other) const
+            {
+                return this->index == other.index;
+            }
+            bool operator!=(const sample_iterator& other) const
+            {
+                return this->index != other.index;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Picks @b k distinct random indices of a random access range, in O(k) (Floyd's algorithm).
+     * @param[in]     first  The first element.
+     * @param[in]     last   The end of the range.
+     * @param[in]     k      The number of elements to pick.
+     * @param[in,out] random The random generator.
+     * @param[out]    picked The indices, unsorted.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void pick(Iterator first, Iterator last, std::size_t k, std::mt19937_64& random,
+              std::vector<std::size_t>& picked, std::random_access_iterator_tag)
+    {
+        std::size_t n = static_cast<std::size_t>(last - first);
+        if (k >= n)
+        {
+            for(std::size_t i=0u;i<n;++i)
+            {
+                picked.push_back(i);
+            }
+            return;
+        }
+        std::unordered_set<std::size_t> chosen(k);
+        for(std::size_t j=n-k;j<n;++j)
+        {
+            std::size_t t = std::uniform_int_distribution<std::size_t>(0u, j)(random);
+            std::size_t index = chosen.insert(t).second ? t : j;
+            chosen.insert(index);
+            picked.push_back(index);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Picks @b k random indices of a forward range in a single pass with a reservoir of @b k elements.
+     * It uses Algorithm L (Li, 1994), which draws random numbers only when an element enters the reservoir.
+     * @param[in]     first  The first element.
+     * @param[in]     last   The end of the range.
+     * @param[in]     k      The number of elements to pick.
+     * @param[in,out] random The random generator.
+     * @param[out]    picked The indices, unsorted.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void pick(Iterator first, Iterator last, std::size_t k, std::mt19937_64& random,
+              std::vector<std::size_t>& picked, std::forward_iterator_tag)
+    {
+        std::size_t index = 0u;
+        for(;index < k && first != last;++index, ++first)
+        {
+            picked.push_back(index);
+        }
+        if (first == last || k == 0u)
+        {
+            return;
+        }
+        std::uniform_real_distribution<double> uniform(std::numeric_limits<double>::min(), 1.0);
+        std::uniform_int_distribution<std::size_t> slot(0u, k - 1u);
+        double w = std::exp(std::log(uniform(random))/static_cast<double>(k));
+        --index;
+        while(true)
+        {
+            double skip = std::floor(std::log(uniform(random))/std::log1p(-w));
+            std::size_t steps = skip < static_cast<double>(std::numeric_limits<std::size_t>::max()/2u) ?
+                                static_cast<std::size_t>(skip) + 1u : std::numeric_limits<std::size_t>::max()/2u;
+            // first points on the element right after index.
+            std::size_t done = ::mtl_details::bounded_advance(first, last, steps - 1u, std::forward_iterator_tag());
+            if (done != steps - 1u || first == last)
+            {
+                return;
+            }
+            index += steps;
+            picked[slot(random)] = index;
+            ++first;
+            w *= std::exp(std::log(uniform(random))/static_cast<double>(k));
+        }
+    }
+}
+
+namespace mtl
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class every_view
+     * @brief A non owning view which displays one element out of @b stride, with its index.
+     * @tparam Container The container you wanna display.
+     * @warning The container must outlive the view.
+     */
+    template<typename Container>
+    class every_view final
+    {
+        private:
+            ::mtl_details::view_storage<Container> container;
+            std::size_t                            stride;
+        public:
+            //! @brief The iterator type returned by begin() and end().
+            typedef ::mtl_details::stride_iterator<typename ::mtl_details::iterator_of<Container>::type> iterator;
+
+            /**
+             * @brief Creates a view on @b c.
+             * @param[in] c    The viewed container.
+             * @param[in] step The distance between two displayed elements.
+             * @throw std::runtime_error If @b step is 0.
+             */
+            every_view(const Container& c, std::size_t step) : container(c), stride(step)
+            {
+                if (step == 0u)
+                {
+                    throw std::runtime_error("mtl::every() with a null stride !");
+                }
+            }
+
+            //! @{
+            //! @brief Implements the <b>iterator-pair idiom</b> for <b>every_view</b>.
+            friend iterator begin(const every_view& view)
+            {
+                return iterator(begin(view.container.get()), end(view.container.get()), view.stride);
+            }
+            friend iterator end(const every_view& view)
+            {
+                return iterator(end(view.container.get()), end(view.container.get()), view.stride);
+            }
+            //! @}
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class sample_view
+     * @brief A view which displays some random elements of a container, in order, with their index.
+     * The elements are picked when the view is created, and only their indices are stored (O(k) memory).
+     * @tparam Container The container you wanna display.
+     * @warning The container must outlive the view, and mustn't change in between.
+     */
+    template<typename Container>
+    class sample_view final
+    {
+        private:
+            typedef typename ::mtl_details::iterator_of<Container>::type Iterator;
+            ::mtl_details::view_storage<Container> container;
+            std::vector<std::size_t>               picked;
+        public:
+            //! @brief The iterator type returned by begin() and end().
+            typedef ::mtl_details::sample_iterator<Iterator> iterator;
+
+            /**
+             * @brief Picks @b k elements of @b c.
+             * @param[in] c    The viewed container.
+             * @param[in] k    The number of elements to pick.
+             * @param[in] seed The seed of the random generator.
+             */
+            sample_view(const Container& c, std::size_t k, std::uint64_t seed) : container(c), picked()
+            {
+                std::mt19937_64 random(seed);
+                this->picked.reserve(k);
+                ::mtl_details::pick(begin(this->container.get()), end(this->container.get()), k, random, this->picked,
+                                    typename std::iterator_traits<Iterator>::iterator_category());
+                std::sort(this->picked.begin(), this->picked.end());
+            }
+
+            //! @{
+            //! @brief Implements the <b>iterator-pair idiom</b> for <b>sample_view</b>.
+            friend iterator begin(const sample_view& view)
+            {
+                return iterator(begin(view.container.get()), end(view.container.get()),
+                                view.picked.data(), view.picked.data() + view.picked.size());
+            }
+            friend iterator end(const sample_view& view)
+            {
+                return iterator(end(view.container.get()), end(view.container.get()),
+                                view.picked.data() + view.picked.size(), view.picked.data() + view.picked.size());
+            }
+            //! @}
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays one element out of @b stride of @b c, each one annotated with its index.
+     * @param[in] c      The container you wanna display.
+     * @param[in] stride The distance between two displayed elements.
+     * @return The view, which could be sent to a std::ostream.
+     * @throw std::runtime_error If @b stride is 0.
+     *
+     * Usage :
+     * @code
+     * std::vector<int> v = {10, 11, 12, 13, 14};
+     * std::cout << mtl::every(v, 2) << std::endl;
+     * // Output : [ #0:10 #2:12 #4:14 ]
+     * @endcode
+     */
+    template<typename Container>
+    every_view<Container> every(const Container& c, std::size_t stride)
+    {
+        return every_view<Container>(c, stride);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b k random elements of @b c, in order, each one annotated with its index.
+     * Random access containers pick k indices directly, others are read once with a reservoir of k elements.
+     * @param[in] c    The container you wanna display.
+     * @param[in] k    The number of elements to display (everything if @b c is smaller).
+     * @param[in] seed The seed of the random generator, so the same sample could be displayed again.
+     * @return The view, which could be sent to a std::ostream.
+     *
+     * Usage :
+     * @code
+     * std::cout << mtl::sample(huge, 100) << std::endl;
+     * // Output : [ #12:3.4 #9981:0.1 ... ]
+     * @endcode
+     */
+    template<typename Container>
+    sample_view<Container> sample(const Container& c, std::size_t k,
+                                  std::uint64_t seed = std::mt19937_64::default_seed)
+    {
+        return sample_view<Container>(c, k, seed);
+    }
+}
+
+namespace mtl_details
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief The terminal case of tuple recursion (shows last element).
+     * @tparam T Any kind of @b std::tuple.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      tuple The @b std::tuple you wanna display.
+     * @param[useless] Isn't use at all, just here to handle the current element number.
+     * warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    void tuple_print_rec(std::ostream& out, const T& tuple, ::mtl_details::Int<MTL_IS_TUPLE>)
+    {
+        out << std::get<std::tuple_size<T>::value-1>(tuple);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief The general case of tuple recursion (shows current element).
+     * @tparam T Any kind of @b std::tuple.
+     * @tparam NThe number of element left to display.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      tuple The @b std::tuple you wanna display.
+     * @param[useless] Isn't use at all, just here to handle the current element number.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T, std::size_t N>
+    void tuple_print_rec(std::ostream& out, const T& tuple, ::mtl_details::Int<N>)
+    {
+        out << std::get<std::tuple_size<T>::value - N>(tuple) << ' ';
+        ::mtl_details::tuple_print_rec(out, tuple, ::mtl_details::Int<N-1>());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Gives the std::ios_base::iword() index holding the minimum run length (0 when disabled).
+     * @return The index, allocated once.
+     * @warning You shall not use this function by yourself.
+     */
+    inline int run_length_index(void)
+    {
+        static const int index = std::ios_base::xalloc();
+        return index;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Gives the std::ios_base::iword() index telling if bits are displayed without separators.
+     * @return The index, allocated once.
+     * @warning You shall not use this function by yourself.
+     */
+    inline int bitstring_index(void)
+    {
+        static const int index = std::ios_base::xalloc();
+        return index;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class bit_writer
+     * @brief Expands bits into '0' and '1' characters (followed by a space unless in bitstring mode),
+     * 8 bits at a time, into a local buffer flushed with a single write.
+     * @warning You shall not use this class by yourself.
+     */
+    class bit_writer final
+    {
+        private:
+            std::ostream& out;
+            char          buffer[4096];
+            std::size_t   used;
+            bool          separated;
+
+            void flush(void)
+            {
+                this->out.write(this->buffer, static_cast<std::streamsize>(this->used));
+                this->used = 0u;
+            }
+        public:
+            /**
+             * @brief Creates a writer on @b output, reading the bitstring mode from it.
+             * @param[in,out] output The output stream you wanna use.
+             */
+            explicit bit_writer(std::ostream& output) : out(output), used(0u),
+                separated(output.iword(::mtl_details::bitstring_index()) == 0)
+            {
+            }
+
+            /**
+             * @brief Writes the @b count low bits of @b bits, lowest bit first.
+             * @param[in] bits  The bits to write.
+             * @param[in] count How many bits to write, 8 at most.
+             */
+            void write(unsigned int bits, unsigned int count)
+            {
+                if (count == 0u)
+                {
+                    // Flushing here could leave nothing buffered for the final space of the bitstring mode.
+                    return;
+                }
+                if (this->used + 16u > sizeof(this->buffer))
+                {
+                    this->flush();
+                }
+                char* cursor = this->buffer + this->used;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                if (count == 8u)
+                {
+                    // Each bit is moved to its own lane, then turned into 0 or 1 and added to '0' (and ' ').
+                    if (this->separated)
+                    {
+                        for(unsigned int half=0u;half<2u;++half)
+                        {
+                            std::uint64_t x = ((bits >> (4u*half)) & 0xFu)*UINT64_C(0x0001000100010001) &
+                                              UINT64_C(0x0008000400020001);
+                            x = (((x + UINT64_C(0x000F000F000F000F)) >> 4u) & UINT64_C(0x0001000100010001)) +
+                                UINT64_C(0x2030203020302030);
+                            std::memcpy(cursor + 8u*half, &x, 8u);
+                        }
+                        this->used += 16u;
+                    }
+                    else
+                    {
+                        std::uint64_t x = (bits & 0xFFu)*UINT64_C(0x0101010101010101) & UINT64_C(0x8040201008040201);
+                        x = (((x + UINT64_C(0x7F7F7F7F7F7F7F7F)) >> 7u) & UINT64_C(0x0101010101010101)) +
+                            UINT64_C(0x3030303030303030);
+                        std::memcpy(cursor, &x, 8u);
+                        this->used += 8u;
+                    }
+                    return;
+                }
+#endif
+                for(unsigned int i=0u;i<count;++i)
+                {
+                    *cursor++ = static_cast<char>('0' + ((bits >> i) & 1u));
+                    if (this->separated)
+                    {
+                        *cursor++ = ' ';
+                    }
+                }
+                this->used = static_cast<std::size_t>(cursor - this->buffer);
+            }
+
+            /**
+             * @brief Flushes the remaining characters, with a final space in bitstring mode.
+             */
+            ~bit_writer(void)
+            {
+                if (!this->separated && this->used != 0u)
+                {
+                    this->buffer[this->used++] = ' ';
+                }
+                this->flush();
+            }
+            bit_writer(const bit_writer&) = delete;
+            bit_writer& operator=(const bit_writer&) = delete;
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Checks if bits could be expanded directly into '0' and '1', like std::num_put does by default.
+     * std::boolalpha, std::showpos, std::showbase (01 or 0x1) and custom std::num_put facets change the
+     * display of each bit, so bits are then displayed one by one like anything else.
+     * @param[in] out The output stream you wanna use.
+     * @return true if the word by word path produces exactly what operator<< would.
+     * @warning You shall not use this function by yourself.
+     */
+    inline bool bit_words_allowed(const std::ostream& out)
+    {
+        return (out.flags() & (std::ios_base::boolalpha | std::ios_base::showpos | std::ios_base::showbase)) == 0 &&
+               &std::use_facet<std::num_put<char>>(out.getloc()) ==
+               &std::use_facet<std::num_put<char>>(std::locale::classic());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class bitset_iterator
+     * @brief Forward iterator on the bits of a std::bitset, bit 0 first, so they could go through print_range().
+     * @tparam N The size of the bitset.
+     * @warning You shall not use this class by yourself.
+     */
+    template<std::size_t N>
+    class bitset_iterator final
+    {
+        private:
+            const std::bitset<N>* set;
+            std::size_t           position;
+        public:
+            typedef bool                      value_type;
+            typedef bool                      reference;
+            typedef const bool*               pointer;
+            typedef std::ptrdiff_t            difference_type;
+            typedef std::forward_iterator_tag iterator_category;
+
+            bitset_iterator(void) : set(nullptr), position(0u)
+            {
+            }
+            bitset_iterator(const std::bitset<N>& b, std::size_t i) : set(&b), position(i)
+            {
+            }
+            reference operator*(void) const
+            {
+                return (*this->set)[this->position];
+            }
+            bitset_iterator& operator++(void)
+            {
+                ++this->position;
+                return *this;
+            }
+            bool operator==(const bitset_iterator& other) const
+            {
+                return this->position == other.position;
+            }
+            bool operator!=(const bitset_iterator& other) const
+            {
+                return this->position != other.position;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class contiguous
+     * @brief Sets @b value to true if @b Iterator walks through contiguous @b T (pointers and std::vector
+     * iterators).
+     * @tparam Iterator The iterator you wanna test.
+     * @tparam T        The type of the elements.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Iterator, typename T>
+    struct contiguous final
+    {
+        enum : std::size_t
+        {
+            value = std::is_same<Iterator, T*>::value || std::is_same<Iterator, const T*>::value ||
+                    std::is_same<Iterator, typename std::vector<T>::const_iterator>::value ||
+                    std::is_same<Iterator, typename std::vector<T>::iterator>::value
+        };
+        MTL_UNCREATABLE(contiguous);
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class strided
+     * @brief Reads numbers laid out at a constant distance from each other, such as a data member of the
+     * elements of an array.
+     * @tparam T The type of the numbers.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    class strided final
+    {
+        private:
+            const char* first;
+            std::size_t stride; // In bytes.
+        public:
+            strided(const T* data, std::size_t bytes) : first(reinterpret_cast<const char*>(data)), stride(bytes)
+            {
+            }
+            const T& operator[](std::size_t i) const
+            {
+                return *reinterpret_cast<const T*>(this->first + i*this->stride);
+            }
+            strided operator+(std::size_t i) const
+            {
+                return strided(&(*this)[i], this->stride);
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class contiguous_arithmetic
+     * @brief Sets @b value to 1 if @b Iterator walks through numbers laid out in memory at a constant distance
+     * (pointers and std::vector iterators, or a data member projected from them by mtl::project()), 0 otherwise.
+     * Such ranges could be processed by blocks the compiler vectorizes : @b data() gives something indexable
+     * on the numbers, and @b distance() their count.
+     * @tparam Iterator The iterator you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Iterator, typename T = typename std::decay<decltype(*std::declval<Iterator>())>::type,
+             bool Arithmetic = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+    struct contiguous_arithmetic final
+    {
+        enum : std::size_t {value = 0u, integral = 0u};
+        MTL_UNCREATABLE(contiguous_arithmetic);
+    };
+    //! @brief Arithmetic case, checks the iterator itself.
+    template<typename Iterator, typename T>
+    struct contiguous_arithmetic<Iterator, T, true> final
+    {
+        enum : std::size_t
+        {
+            value    = ::mtl_details::contiguous<Iterator, T>::value,
+            integral = value && std::is_integral<T>::value //!< Integers could even be compared bitwise.
+        };
+        static const T* data(const Iterator& first)
+        {
+            return &*first;
+        }
+        static std::size_t distance(const Iterator& first, const Iterator& last)
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+        MTL_UNCREATABLE(contiguous_arithmetic);
+    };
+    //! @brief Data member case, checks the iterator on the objects, the numbers are one object size apart.
+    template<typename Iterator, typename Class, typename T>
+    struct contiguous_arithmetic<::mtl_details::projection_iterator<Iterator, ::mtl_details::member_projection<Class, T>>,
+                                 T, true> final
+    {
+        typedef ::mtl_details::projection_iterator<Iterator, ::mtl_details::member_projection<Class, T>> Projection;
+        enum : std::size_t
+        {
+            value    = ::mtl_details::contiguous<Iterator, Class>::value,
+            integral = value && std::is_integral<T>::value //!< Integers could even be compared bitwise.
+        };
+        static ::mtl_details::strided<T> data(const Projection& first)
+        {
+            return ::mtl_details::strided<T>(&*first, sizeof(Class));
+        }
+        static std::size_t distance(const Projection& first, const Projection& last)
+        {
+            return static_cast<std::size_t>(last.base() - first.base());
+        }
+        MTL_UNCREATABLE(contiguous_arithmetic);
+    };
+    //! @}
+
+    template<typename T>
+    struct equality_comparable;
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class elements_comparable
+     * @brief Sets @b value to 1 if the elements of @b T (if any) match equality_comparable.
+     * The operator== of the standard containers and tuples is declared for any element type, it only fails
+     * once instantiated, so the elements must be checked too.
+     * @tparam T    The type you wanna test.
+     * @tparam Kind 1 for a range, 2 for a tuple and 0 for anything else.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T, std::size_t Kind = ::mtl_details::has_iterators<T>::value ? 1u :
+                                            ::mtl_details::is_tuplable<T>::value != 0u ? 2u : 0u>
+    struct elements_comparable final
+    {
+        MTL_UNCREATABLE(elements_comparable);
+        enum : std::size_t {value = 1u};
+    };
+    //! @brief Range case, its elements must be comparable (a range of itself, such as a path, stops here).
+    template<typename T>
+    struct elements_comparable<T, 1u> final
+    {
+        private:
+            typedef typename std::decay<decltype(*std::declval<typename ::mtl_details::iterator_of<T>::type>())>::type
+                Element;
+        public:
+            MTL_UNCREATABLE(elements_comparable);
+            enum : std::size_t
+            {
+                value = std::is_same<Element, T>::value || ::mtl_details::equality_comparable<Element>::value
+            };
+    };
+    //! @brief Tuple case, each element must be comparable.
+    template<typename T, std::size_t N = std::tuple_size<T>::value>
+    struct tuple_comparable final
+    {
+        MTL_UNCREATABLE(tuple_comparable);
+        enum : std::size_t
+        {
+            value = ::mtl_details::equality_comparable<
+                        typename std::decay<typename std::tuple_element<N-1u, T>::type>::type>::value &&
+                    ::mtl_details::tuple_comparable<T, N-1u>::value
+        };
+    };
+    template<typename T>
+    struct tuple_comparable<T, 0u> final
+    {
+        MTL_UNCREATABLE(tuple_comparable);
+        enum : std::size_t {value = 1u};
+    };
+    template<typename T>
+    struct elements_comparable<T, 2u> final
+    {
+        MTL_UNCREATABLE(elements_comparable);
+        enum : std::size_t {value = ::mtl_details::tuple_comparable<T>::value};
+    };
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class equality_comparable
+     * @brief Sets @b value to true if two @b T could be compared with an operator== returning a bool.
+     * Run-length display compares neighbours, elements which can't be compared are always displayed.
+     * @tparam T The type you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    struct equality_comparable final
+    {
+        private:
+            // std::valarray has an operator==, but it returns a std::valarray<bool>.
+            template<typename U, typename R = decltype(std::declval<const U&>() == std::declval<const U&>())>
+            static constexpr bool check(int)
+            {
+                return std::is_convertible<R, bool>::value;
+            }
+            template<typename U>
+            static constexpr bool check(...)
+            {
+                return false;
+            }
+        public:
+            MTL_UNCREATABLE(equality_comparable);
+            enum : std::size_t
+            {
+                value = equality_comparable<T>::check<typename std::decay<T>::type>(0) &&
+                        ::mtl_details::elements_comparable<typename std::decay<T>::type>::value
+            };
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Finds the end of the run starting at @b first, for contiguous integers.
+     * Elements are compared by blocks without any early exit, so the compiler vectorizes the comparisons.
+     * @param[in] data  The integers, see contiguous_arithmetic::data().
+     * @param[in] first The index of the first element of the run.
+     * @param[in] last  The number of integers.
+     * @return The index of the first element different from data[first], or @b last.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Data>
+    std::size_t run_end(const Data& data, std::size_t first, std::size_t last)
+    {
+        typedef typename std::decay<decltype(data[0u])>::type T;
+        const std::size_t block = 32u;
+        const T value = data[first];
+        std::size_t it = first + 1u;
+        while(last - it >= block)
+        {
+            T differences = 0;
+            for(std::size_t i=0u;i<block;++i)
+            {
+                differences |= static_cast<T>(data[it+i] ^ value);
+            }
+            if (differences != 0)
+            {
+                break;
+            }
+            it += block;
+        }
+        while(it != last && data[it] == value)
+        {
+            ++it;
+        }
+        return it;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Writes " x<count> " after a collapsed run, always in decimal whatever the stream flags are.
+     * @param[in,out] out   The output stream you wanna use.
+     * @param[in]     count The length of the run.
+     * @warning You shall not use this function by yourself.
+     */
+    inline void print_run_count(std::ostream& out, std::size_t count)
+    {
+        char buffer[std::numeric_limits<std::size_t>::digits10 + 4u];
+        char* cursor = buffer + sizeof(buffer);
+        *--cursor = ' ';
+        do
+        {
+            *--cursor = static_cast<char>('0' + count % 10u);
+            count /= 10u;
+        } while(count != 0u);
+        *--cursor = 'x';
+        *--cursor = ' ';
+        out.write(cursor, buffer + sizeof(buffer) - cursor);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints [first, last) collapsing runs of at least @b min_run equal elements, for any range.
+     * @param[in,out]  out     The output stream you wanna use.
+     * @param[in]      first   The first element.
+     * @param[in]      last    The end of the range.
+     * @param[in]      min_run The minimum length of a collapsed run.
+     * @param[useless]         Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_runs(std::ostream& out, Iterator first, Iterator last, std::size_t min_run, ::mtl_details::Int<0u>)
+    {
+        while(first != last)
+        {
+            Iterator next = first;
+            std::size_t count = 1u;
+            for(++next;next != last && *next == *first;++next)
+            {
+                ++count;
+            }
+            if (count >= min_run)
+            {
+                out << *first;
+                ::mtl_details::print_run_count(out, count);
+                first = next;
+            }
+            for(;first != next;++first)
+            {
+                out << *first << ' ';
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints [first, last) collapsing runs of at least @b min_run equal elements, for contiguous integers.
+     * @param[in,out]  out     The output stream you wanna use.
+     * @param[in]      first   The first element.
+     * @param[in]      last    The end of the range.
+     * @param[in]      min_run The minimum length of a collapsed run.
+     * @param[useless]         Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_runs(std::ostream& out, Iterator first, Iterator last, std::size_t min_run, ::mtl_details::Int<1u>)
+    {
+        if (first == last)
+        {
+            return;
+        }
+        auto data = ::mtl_details::contiguous_arithmetic<Iterator>::data(first);
+        std::size_t end = ::mtl_details::contiguous_arithmetic<Iterator>::distance(first, last);
+        std::size_t it = 0u;
+        while(it != end)
+        {
+            std::size_t next = ::mtl_details::run_end(data, it, end);
+            if (next - it >= min_run)
+            {
+                out << data[it];
+                ::mtl_details::print_run_count(out, next - it);
+                it = next;
+            }
+            for(;it != next;++it)
+            {
+                out << data[it] << ' ';
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class traversal
+     * @brief Chooses how to walk through a range according to its @b Iterator.
+     * @b value is 0 for a plain loop, 2 for node based containers (std::list, std::set, std::unordered_map, ...),
+     * whose nodes are prefetched, and 3 for std::vector<bool> (word by word, libstdc++ only).
+     * Prefetching walks a second iterator ahead, so single pass (input) iterators always use a plain loop.
+     * @tparam Iterator The iterator you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename Iterator>
+    struct traversal final
+    {
+        enum : std::size_t
+        {
+            value = std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>::value &&
+                    !std::is_base_of<std::random_access_iterator_tag,
+                                     typename std::iterator_traits<Iterator>::iterator_category>::value &&
+                    std::is_lvalue_reference<decltype(*std::declval<Iterator>())>::value ? 2u : 0u
+        };
+        MTL_UNCREATABLE(traversal);
+    };
+    template<typename Iterator, typename Function>
+    struct traversal<::mtl_details::projection_iterator<Iterator, Function>> final
+    {
+        enum : std::size_t {value = 0u};
+        MTL_UNCREATABLE(traversal);
+    };
+    template<typename Iterator, typename Predicate>
+    struct traversal<::mtl_details::filter_iterator<Iterator, Predicate>> final
+    {
+        enum : std::size_t {value = 0u};
+        MTL_UNCREATABLE(traversal);
+    };
+#ifdef __GLIBCXX__
+    template<>
+    struct traversal<std::_Bit_const_iterator> final
+    {
+        enum : std::size_t {value = 3u};
+        MTL_UNCREATABLE(traversal);
+    };
+    template<>
+    struct traversal<std::_Bit_iterator> final
+    {
+        enum : std::size_t {value = 3u};
+        MTL_UNCREATABLE(traversal);
+    };
+#endif
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints each element of [first, last) followed by a space, with a plain loop.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      first The first element.
+     * @param[in]      last  The end of the range.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_elements(std::ostream& out, Iterator first, Iterator last, ::mtl_details::Int<0u>)
+    {
+        for(;first != last;++first)
+        {
+            out << *first << ' ';
+        }
+    }
+
+#ifdef __GLIBCXX__
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints each bit of a std::vector<bool> followed by a space (or not, in bitstring mode).
+     * The underlying words are read directly, instead of going through a proxy and std::num_put per bit.
+     * When the stream changes the display of a bit (see bit_words_allowed()), bits are displayed one by one.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      first The first element.
+     * @param[in]      last  The end of the range.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_elements(std::ostream& out, Iterator first, Iterator last, ::mtl_details::Int<3u>)
+    {
+        if (!::mtl_details::bit_words_allowed(out))
+        {
+            ::mtl_details::print_elements(out, first, last, ::mtl_details::Int<0u>());
+            return;
+        }
+        typedef typename std::remove_cv<typename std::remove_pointer<decltype(first._M_p)>::type>::type Word;
+        const unsigned int word_bits = static_cast<unsigned int>(std::numeric_limits<Word>::digits);
+        ::mtl_details::bit_writer writer(out);
+        const Word* word = first._M_p;
+        unsigned int offset = first._M_offset;
+        std::size_t count = static_cast<std::size_t>(last - first);
+        while(count != 0u)
+        {
+            Word bits = *word >> offset;
+            std::size_t n = word_bits - offset < count ? word_bits - offset : count;
+            count -= n;
+            for(;n >= 8u;n-=8u)
+            {
+                writer.write(static_cast<unsigned int>(bits & 0xFFu), 8u);
+                bits >>= 8u;
+            }
+            writer.write(static_cast<unsigned int>(bits & 0xFFu), static_cast<unsigned int>(n));
+            ++word;
+            offset = 0u;
+        }
+    }
+#endif
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints each element of a node based container followed by a space.
+     * A second iterator runs MTL_PREFETCH_DISTANCE nodes ahead and prefetches them, so cache misses overlap
+     * with the formatting of the current elements instead of stalling each step.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      first The first element.
+     * @param[in]      last  The end of the range.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_elements(std::ostream& out, Iterator first, Iterator last, ::mtl_details::Int<2u>)
+    {
+        Iterator ahead = first;
+        for(std::size_t i=0u;i<MTL_PREFETCH_DISTANCE && ahead != last;++i)
+        {
+            ++ahead;
+        }
+        for(;first != last;++first)
+        {
+            if (ahead != last)
+            {
+                MTL_PREFETCH(std::addressof(*ahead));
+                ++ahead;
+            }
+            out << *first << ' ';
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Elements without operator== can't be collapsed, nor single pass ranges which can't be read twice,
+     * so they are all printed.
+     * @param[in,out]  out   The output stream you wanna use.
+     * @param[in]      first The first element.
+     * @param[in]      last  The end of the range.
+     * @param[useless]       Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_runs(std::ostream& out, Iterator first, Iterator last, std::size_t, ::mtl_details::Int<2u>)
+    {
+        ::mtl_details::print_elements(out, first, last,
+                                      ::mtl_details::Int<::mtl_details::traversal<Iterator>::value>());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints each element of [first, last) followed by a space.
+     * Runs of equal elements are collapsed if it has been asked with mtl::run_length.
+     * @param[in,out] out   The output stream you wanna use.
+     * @param[in]     first The first element.
+     * @param[in]     last  The end of the range.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Iterator>
+    void print_range(std::ostream& out, Iterator first, Iterator last)
+    {
+        std::size_t min_run = static_cast<std::size_t>(out.iword(::mtl_details::run_length_index()));
+        if (min_run > 1u)
+        {
+            ::mtl_details::print_runs(out, first, last, min_run, ::mtl_details::Int<
+                !::mtl_details::equality_comparable<decltype(*first)>::value ||
+                !::mtl_details::multi_pass<Iterator>::value ? 2u :
+                static_cast<std::size_t>(::mtl_details::contiguous_arithmetic<Iterator>::integral)>());
+            return;
+        }
+        ::mtl_details::print_elements(out, first, last,
+                                      ::mtl_details::Int<::mtl_details::traversal<Iterator>::value>());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints a container which match the std::tuple interface.
+     * @tparam Container The container you wanna display.
+     * @param[in,out]  out       The output stream you wanna use.
+     * @param[in]      container The container you wanna display.
+     * @param[useless]           Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Container>
+    std::ostream& print(std::ostream& out, const Container& container, ::mtl_details::Int<MTL_IS_NOT_TUPLE>)
+    {
+        out << "[ ";
+        ::mtl_details::print_range(out, begin(container), end(container));
+        return out << ']';
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class fast_format
+     * @brief Sets @b value to 1 if @b T is a number whose output has a known maximum length, 0 otherwise.
+     * @b size is this maximum length followed by a space : enough for a sign, a base prefix and every binary
+     * digit (the worst case, octal is shorter) each followed by a thousands separator.
+     * Characters and booleans are excluded, because they aren't always displayed as numbers.
+     * @tparam T The type you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    struct fast_format final
+    {
+        // Not an enum : adding two enumerations of different types is deprecated in C++20.
+        static constexpr std::size_t value =
+            std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+            !std::is_same<T, char>::value && !std::is_same<T, signed char>::value &&
+            !std::is_same<T, unsigned char>::value && !std::is_same<T, wchar_t>::value &&
+            !std::is_same<T, char16_t>::value && !std::is_same<T, char32_t>::value;
+        static constexpr std::size_t size =
+            !value ? 0u : std::is_integral<T>::value ?
+                2u*static_cast<std::size_t>(std::numeric_limits<T>::digits) + 4u :
+                2u*(static_cast<std::size_t>(std::numeric_limits<long double>::max_digits10) + 12u);
+        MTL_UNCREATABLE(fast_format);
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class fast_tuple
+     * @brief Sets @b value to 1 if every element of the tuple @b T matches fast_format, and @b size to the sum
+     * of their maximum length.
+     * @tparam T The tuple you wanna test.
+     * @tparam N The number of elements left to test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T, std::size_t N = std::tuple_size<T>::value>
+    struct fast_tuple final
+    {
+        private:
+            typedef typename std::decay<typename std::tuple_element<N-1u, T>::type>::type Element;
+            typedef ::mtl_details::fast_format<Element> Current;
+            typedef ::mtl_details::fast_tuple<T, N-1u>  Next;
+        public:
+            static constexpr std::size_t value =
+                Current::value && Next::value && std::tuple_size<T>::value <= MTL_SMALL_TUPLE_MAX;
+            static constexpr std::size_t size = Current::size + Next::size;
+            MTL_UNCREATABLE(fast_tuple);
+    };
+    //! @brief End of recursion, an empty tuple is never formatted this way.
+    template<typename T>
+    struct fast_tuple<T, 0u> final
+    {
+        static constexpr std::size_t value = std::tuple_size<T>::value != 0u;
+        static constexpr std::size_t size  = 0u;
+        MTL_UNCREATABLE(fast_tuple);
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class buffer_num_put
+     * @brief The std::num_put facet writing into a char buffer instead of a stream buffer.
+     * @warning You shall not use this class by yourself.
+     */
+    struct buffer_num_put final : public std::num_put<char, char*>
+    {
+        buffer_num_put(void) : std::num_put<char, char*>(1u)
+        {
+        }
+        ~buffer_num_put(void) = default;
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Checks if the state of @b out allows to format numbers into a fixed size buffer.
+     * A width, a fixed notation, a huge precision or a custom std::num_put facet disable it.
+     * @param[in] out The output stream you wanna use.
+     * @return true if the fast path produces exactly what operator<< would.
+     * @warning You shall not use this function by yourself.
+     */
+    inline bool fast_format_allowed(const std::ostream& out)
+    {
+        return out.width() == 0 &&
+               (out.flags() & std::ios_base::floatfield) != std::ios_base::fixed &&
+               out.precision() <= std::numeric_limits<long double>::max_digits10 &&
+               &std::use_facet<std::num_put<char>>(out.getloc()) ==
+               &std::use_facet<std::num_put<char>>(std::locale::classic());
+    }
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @brief Converts a number the same way std::ostream::operator<< does before calling std::num_put.
+     * @param[in] out   The output stream you wanna use (its base matters for signed types).
+     * @param[in] value The number to convert.
+     * @return The number, as a type accepted by std::num_put.
+     * @warning You shall not use these functions by yourself.
+     */
+    inline long to_num_put(const std::ostream& out, short value)
+    {
+        std::ios_base::fmtflags base = out.flags() & std::ios_base::basefield;
+        return base == std::ios_base::oct || base == std::ios_base::hex ?
+               static_cast<long>(static_cast<unsigned short>(value)) : static_cast<long>(value);
+    }
+    inline long to_num_put(const std::ostream& out, int value)
+    {
+        std::ios_base::fmtflags base = out.flags() & std::ios_base::basefield;
+        return base == std::ios_base::oct || base == std::ios_base::hex ?
+               static_cast<long>(static_cast<unsigned int>(value)) : static_cast<long>(value);
+    }
+    inline unsigned long to_num_put(const std::ostream&, unsigned short value)
+    {
+        return value;
+    }
+    inline unsigned long to_num_put(const std::ostream&, unsigned int value)
+    {
+        return value;
+    }
+    inline double to_num_put(const std::ostream&, float value)
+    {
+        return value;
+    }
+    template<typename T>
+    T to_num_put(const std::ostream&, T value)
+    {
+        return value;
+    }
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief The terminal case of fast tuple recursion, everything has been formatted.
+     * @param[in] cursor Where the next character goes.
+     * @return @b cursor
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    char* tuple_put_rec(char* cursor, std::ostream&, const T&, ::mtl_details::Int<0u>)
+    {
+        return cursor;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief The general case of fast tuple recursion, formats the current element and a space.
+     * The recursion is resolved at compile time, so the whole tuple is formatted without any loop.
+     * @tparam T Any kind of @b std::tuple matching fast_tuple.
+     * @tparam N The number of element left to format.
+     * @param[in]     cursor Where the next character goes.
+     * @param[in,out] out    The output stream, which provides flags and locale.
+     * @param[in]     tuple  The @b std::tuple you wanna format.
+     * @return The position after the last written character.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T, std::size_t N>
+    char* tuple_put_rec(char* cursor, std::ostream& out, const T& tuple, ::mtl_details::Int<N>)
+    {
+        static const ::mtl_details::buffer_num_put formatter;
+        cursor = formatter.put(cursor, out, out.fill(),
+                               ::mtl_details::to_num_put(out, std::get<std::tuple_size<T>::value - N>(tuple)));
+        *cursor++ = ' ';
+        return ::mtl_details::tuple_put_rec(cursor, out, tuple, ::mtl_details::Int<N-1u>());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints a tuple element by element.
+     * @tparam Container The tuple you wanna display.
+     * @param[in,out]  out       The output stream you wanna use.
+     * @param[in]      container The tuple you wanna display.
+     * @param[useless]           Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Container>
+    std::ostream& print_tuple(std::ostream& out, const Container& container, ::mtl_details::Int<0u>)
+    {
+        out << "( ";
+        ::mtl_details::tuple_print_rec(out, container,
+                                       ::mtl_details::Int<std::tuple_size<Container>::value>());
+        return out << " )";
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints a small tuple of numbers with a single write.
+     * The maximum output length is known at compile time, so everything is formatted into a stack buffer.
+     * @tparam Container The tuple you wanna display.
+     * @param[in,out]  out       The output stream you wanna use.
+     * @param[in]      container The tuple you wanna display.
+     * @param[useless]           Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Container>
+    std::ostream& print_tuple(std::ostream& out, const Container& container, ::mtl_details::Int<1u>)
+    {
+        if (!::mtl_details::fast_format_allowed(out))
+        {
+            return ::mtl_details::print_tuple(out, container, ::mtl_details::Int<0u>());
+        }
+        char buffer[::mtl_details::fast_tuple<Container>::size + 3u];
+        char* cursor = buffer;
+        *cursor++ = '(';
+        *cursor++ = ' ';
+        cursor = ::mtl_details::tuple_put_rec(cursor, out, container,
+                                              ::mtl_details::Int<std::tuple_size<Container>::value>());
+        *cursor++ = ')';
+        return out.write(buffer, cursor - buffer);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Prints a container which doesn't the std::tuple interface.
+     * @tparam Container The container you wanna display.
+     * @param[in,out]  out       The output stream you wanna use.
+     * @param[in]      container The container you wanna display.
+     * @param[useless]           Isn't use at all, just here to select this function.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename Container>
+    std::ostream& print(std::ostream& out, const Container& container, ::mtl_details::Int<MTL_IS_TUPLE>)
+    {
+        return ::mtl_details::print_tuple(out, container,
+                                          ::mtl_details::Int<::mtl_details::fast_tuple<Container>::value>());
+    }
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief Defines an overload for C-style arrays, but not for char and unsigned char arrays.
+ * Because it conflicts with current implementation of the STL.
+ * @tparam ArrayType The type of your array.
+ * @tparam N         The number of element of this array.
+ * @param[in,out] out   The output stream you wanna use.
+ * @param[in]     array The C-style array you wanna display.
+ *
+ * The trailing return type (auto and ->) ensures than ArrayType isn't char or unsigned char.@n
+ * (out) ensures than we create a std::ostream& as return type.@n
+ * Anyway, you could use it simply :
+ * @code
+ * int zeInts[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+ * std::cout << zeInts << std::endl;
+ * // Output : [ 1 2 3 4 5 6 7 8 ]
+ * @endcode
+ * @return @b out as std::ostream& (I sware it does).
+ */
+template<typename ArrayType, std::size_t N>
+auto operator<<(std::ostream& out, const ArrayType (&array)[N])
+    -> decltype(::mtl_details::is_not_char<ArrayType>(), (out))
+{
+    return ::mtl_details::print(out, array, ::mtl_details::Int<MTL_IS_NOT_TUPLE>());
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief Defines an overload for std::array.
+ * @tparam ArrayType The type of your array.
+ * @tparam N         The number of element of this array.
+ * @param[in,out] output The output stream you wanna use.
+ * @param[in]     array  The std::array array you wanna display.
+ *
+ * You could use it simply :
+ * @code
+ * std::array<int, 8> array;
+ * // Fill it with 1 2 3 4 5 6 7 8
+ * std::cout << array << std::endl;
+ * // Output : ( 1 2 3 4 5 6 7 8 )
+ * @endcode
+ * @return @b output
+ */
+template<typename T, std::size_t S>
+std::ostream& operator<<(std::ostream& output, const std::array<T, S>& array)
+{
+    if (output.iword(::mtl_details::run_length_index()) > 1)
+    {
+        output << "( ";
+        ::mtl_details::print_range(output, array.begin(), array.end());
+        return output << ')';
+    }
+    return ::mtl_details::print(output, array, ::mtl_details::Int<MTL_IS_TUPLE>());
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief Defines an overload for most of STL containers (except std::array).
+ * @tparam Container A type which accept multiple template arguments.
+ * @tparam Values    Every @b Container template argument types.
+ * @param[in,out] output The output stream you wanna use.
+ * @param[in]     c      The STL container you wanna display.
+ *
+ * It works on :
+ *   - std::vector
+ *   - std::list
+ *   - std::forward_list
+ *   - std::deque
+ *   - std::queue
+ *   - std::stack
+ *   - std::set
+ *   - std::unordered_set
+ *   - std::map
+ *   - std::unordered_map
+ *   - std::valarray
+ *   - std::pair
+ *   - std::tuple
+ *   - std::priority_queue
+ *   - std::multiset
+ *   - std::unordered_multiset
+ *   - std::multimap
+ *   - std::unordered_multimap
+ *
+ * It is simply to use either :
+ * @code
+ * // Create any container as cont;
+ * // Fill it
+ * std::cout << cont << std::endl;
+ * @endcode
+ * @return @b output
+ */
+template<template<typename...> class Container, typename... Types>
+auto operator<<(std::ostream& output, const Container<Types...>& c)
+    -> decltype(std::ignore = typename mtl_details::enable_if_not_same<std::basic_string, Container>::type{},
+                std::ignore = typename mtl_details::grant_access<
+                    mtl_details::has_iterators<Container<Types...>>::value ||
+                    mtl_details::is_tuplable<Container<Types...>>::value>::granted{},
+                (output))
+{
+    typedef typename std::decay<decltype(c)>::type RawType;
+    constexpr std::size_t N = ::mtl_details::is_tuplable<RawType>::value;
+    return ::mtl_details::print(output, c, ::mtl_details::Int<N>());
+}
+
+namespace mtl
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class run_length
+     * @brief A manipulator which collapses runs of equal consecutive elements while displaying containers.
+     * A run of at least @b min_run elements is displayed once, followed by its length.
+     *
+     * Usage :
+     * @code
+     * std::vector<int> v(4096, 0);
+     * v.push_back(7);
+     * std::cout << mtl::run_length(4) << v << std::endl;
+     * // Output : [ 0 x4096 7 ]
+     * std::cout << mtl::run_length(0); // Back to the full display.
+     * @endcode
+     */
+    struct run_length final
+    {
+        std::size_t min_run; //!< The minimum length of a collapsed run, 0 or 1 disables it.
+
+        /**
+         * @brief Creates the manipulator.
+         * @param[in] min Runs shorter than @b min are displayed element by element.
+         */
+        explicit run_length(std::size_t min = 2u) : min_run(min)
+        {
+        }
+
+        /**
+         * @brief Applies the manipulator on @b out, until another one replaces it.
+         * @param[in,out] out         The output stream you wanna use.
+         * @param[in]     manipulator The minimum run length.
+         * @return @b out
+         */
+        friend std::ostream& operator<<(std::ostream& out, const run_length& manipulator)
+        {
+            out.iword(::mtl_details::run_length_index()) = static_cast<long>(manipulator.min_run);
+            return out;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class bitstring
+     * @brief A manipulator which displays std::vector<bool> and mtl::bits() without separators between bits.
+     *
+     * Usage :
+     * @code
+     * std::vector<bool> mask = {true, false, true};
+     * std::cout << mtl::bitstring() << mask << std::endl;
+     * // Output : [ 101 ]
+     * std::cout << mtl::bitstring(false); // Back to [ 1 0 1 ].
+     * @endcode
+     */
+    struct bitstring final
+    {
+        bool enabled; //!< true to remove the separators.
+
+        /**
+         * @brief Creates the manipulator.
+         * @param[in] enable true to remove the separators, false to put them back.
+         */
+        explicit bitstring(bool enable = true) : enabled(enable)
+        {
+        }
+
+        /**
+         * @brief Applies the manipulator on @b out, until another one replaces it.
+         * @param[in,out] out         The output stream you wanna use.
+         * @param[in]     manipulator The mode.
+         * @return @b out
+         */
+        friend std::ostream& operator<<(std::ostream& out, const bitstring& manipulator)
+        {
+            out.iword(::mtl_details::bitstring_index()) = manipulator.enabled;
+            return out;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class bits_view
+     * @brief A non owning view which displays a std::bitset like a std::vector<bool> (bit 0 first).
+     * std::bitset already has its own operator<< (highest bit first, without brackets), so this one is explicit.
+     * @tparam N The size of the bitset.
+     * @warning The bitset must outlive the view.
+     */
+    template<std::size_t N>
+    class bits_view final
+    {
+        private:
+            const std::bitset<N>* set;
+        public:
+            /**
+             * @brief Creates a view on @b b.
+             * @param[in] b The viewed bitset.
+             */
+            explicit bits_view(const std::bitset<N>& b) : set(&b)
+            {
+            }
+
+            /**
+             * @brief Displays the bits, 8 at a time unless the stream changes the display of a bit.
+             * Runs are collapsed in run-length mode, like std::vector<bool>.
+             * @param[in,out] out  The output stream you wanna use.
+             * @param[in]     view The bits to display.
+             * @return @b out
+             */
+            friend std::ostream& operator<<(std::ostream& out, const bits_view& view)
+            {
+                out << "[ ";
+                if (out.iword(::mtl_details::run_length_index()) > 1)
+                {
+                    ::mtl_details::print_range(out, ::mtl_details::bitset_iterator<N>(*view.set, 0u),
+                                               ::mtl_details::bitset_iterator<N>(*view.set, N));
+                    return out << ']';
+                }
+                if (!::mtl_details::bit_words_allowed(out))
+                {
+                    for(std::size_t i=0u;i<N;++i)
+                    {
+                        out << (*view.set)[i] << ' ';
+                    }
+                    return out << ']';
+                }
+                {
+                    ::mtl_details::bit_writer writer(out);
+                    for(std::size_t i=0u;i<N;i+=8u)
+                    {
+                        unsigned int count = N - i < 8u ? static_cast<unsigned int>(N - i) : 8u;
+                        unsigned int bits = 0u;
+                        for(unsigned int k=0u;k<count;++k)
+                        {
+                            bits |= static_cast<unsigned int>((*view.set)[i+k]) << k;
+                        }
+                        writer.write(bits, count);
+                    }
+                }
+                return out << ']';
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b b like a container of bits, bit 0 first.
+     * @param[in] b The bitset you wanna display.
+     * @return The view, which could be sent to a std::ostream.
+     *
+     * Usage :
+     * @code
+     * std::bitset<4> b(0x5);
+     * std::cout << mtl::bits(b) << std::endl;
+     * // Output : [ 1 0 1 0 ]
+     * @endcode
+     */
+    template<std::size_t N>
+    bits_view<N> bits(const std::bitset<N>& b)
+    {
+        return bits_view<N>(b);
+    }
+}
+
+namespace mtl_details
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Checks if @b value is a NaN, it is always false for integers.
+     * @param[in] value The number to test.
+     * @return true if @b value isn't equal to itself.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    bool is_nan(T value)
+    {
+        return value != value;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class p2_quantile
+     * @brief Estimates a quantile in constant memory with the P-square algorithm (Jain and Chlamtac, 1985).
+     * Five markers follow the minimum, the maximum, the quantile and two intermediate positions.
+     * @warning You shall not use this class by yourself.
+     */
+    class p2_quantile final
+    {
+        private:
+            double      heights[5];
+            double      positions[5];
+            double      desired[5];
+            double      increments[5];
+            double      p;
+            std::size_t count;
+
+            double parabolic(std::size_t i, double d) const
+            {
+                return this->heights[i] + d/(this->positions[i+1u] - this->positions[i-1u]) *
+                    ((this->positions[i] - this->positions[i-1u] + d)*(this->heights[i+1u] - this->heights[i]) /
+                     (this->positions[i+1u] - this->positions[i]) +
+                     (this->positions[i+1u] - this->positions[i] - d)*(this->heights[i] - this->heights[i-1u]) /
+                     (this->positions[i] - this->positions[i-1u]));
+            }
+            double linear(std::size_t i, double d) const
+            {
+                std::size_t j = d > 0.0 ? i+1u : i-1u;
+                return this->heights[i] + d*(this->heights[j] - this->heights[i])/(this->positions[j] - this->positions[i]);
+            }
+        public:
+            /**
+             * @brief Creates an estimator for the quantile @b quantile.
+             * @param[in] quantile The quantile to estimate, within [0, 1].
+             */
+            explicit p2_quantile(double quantile) : heights(), positions(), desired(), increments(),
+                p(quantile), count(0u)
+            {
+            }
+
+            /**
+             * @brief Updates the estimation with @b x.
+             * @param[in] x The new observation.
+             */
+            void add(double x)
+            {
+                if (this->count < 5u)
+                {
+                    this->heights[this->count++] = x;
+                    if (this->count == 5u)
+                    {
+                        std::sort(this->heights, this->heights + 5);
+                        for(std::size_t i=0u;i<5u;++i)
+                        {
+                            this->positions[i] = static_cast<double>(i + 1u);
+                        }
+                        const double init[5] = {1.0, 1.0 + 2.0*this->p, 1.0 + 4.0*this->p, 3.0 + 2.0*this->p, 5.0};
+                        const double step[5] = {0.0, this->p/2.0, this->p, (1.0 + this->p)/2.0, 1.0};
+                        std::copy(init, init + 5, this->desired);
+                        std::copy(step, step + 5, this->increments);
+                    }
+                    return;
+                }
+                std::size_t k = 0u;
+                if (x < this->heights[0])
+                {
+                    this->heights[0] = x;
+                }
+                else if (x >= this->heights[4])
+                {
+                    this->heights[4] = x;
+                    k = 3u;
+                }
+                else
+                {
+                    while(x >= this->heights[k+1u])
+                    {
+                        ++k;
+                    }
+                }
+                for(std::size_t i=k+1u;i<5u;++i)
+                {
+                    this->positions[i] += 1.0;
+                }
+                for(std::size_t i=0u;i<5u;++i)
+                {
+                    this->desired[i] += this->increments[i];
+                }
+                for(std::size_t i=1u;i<4u;++i)
+                {
+                    double d = this->desired[i] - this->positions[i];
+                    if ((d >= 1.0 && this->positions[i+1u] - this->positions[i] > 1.0) ||
+                        (d <= -1.0 && this->positions[i-1u] - this->positions[i] < -1.0))
+                    {
+                        d = d > 0.0 ? 1.0 : -1.0;
+                        double height = this->parabolic(i, d);
+                        if (!(this->heights[i-1u] < height && height < this->heights[i+1u]))
+                        {
+                            height = this->linear(i, d);
+                        }
+                        this->heights[i] = height;
+                        this->positions[i] += d;
+                    }
+                }
+                ++this->count;
+            }
+
+            /**
+             * @brief Gives the current estimation, exact up to 5 observations.
+             * @return The estimated quantile (0 without any observation).
+             */
+            double value(void) const
+            {
+                if (this->count > 5u)
+                {
+                    return this->heights[2];
+                }
+                if (this->count == 0u)
+                {
+                    return 0.0;
+                }
+                double sorted[5];
+                std::copy(this->heights, this->heights + this->count, sorted);
+                std::sort(sorted, sorted + this->count);
+                return sorted[static_cast<std::size_t>(this->p*static_cast<double>(this->count - 1u) + 0.5)];
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class statistics
+     * @brief Accumulates count, min, max, mean and variance in one pass, NaNs are counted apart.
+     * The variance uses Welford's update, and Chan's formula to merge blocks.
+     * @tparam T The arithmetic type of the values.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    struct statistics final
+    {
+        std::size_t count; //!< Number of values (NaNs excluded).
+        std::size_t nans;  //!< Number of NaNs.
+        T           min;   //!< Smallest value.
+        T           max;   //!< Biggest value.
+        double      mean;  //!< Mean of the values.
+        double      m2;    //!< Sum of squared differences from the mean.
+
+        statistics(void) : count(0u), nans(0u), min(), max(), mean(0.0), m2(0.0)
+        {
+        }
+
+        /**
+         * @brief Adds a single value.
+         * @param[in] x The value.
+         */
+        void add(T x)
+        {
+            if (::mtl_details::is_nan(x))
+            {
+                ++this->nans;
+                return;
+            }
+            if (this->count == 0u || x < this->min)
+            {
+                this->min = x;
+            }
+            if (this->count == 0u || x > this->max)
+            {
+                this->max = x;
+            }
+            ++this->count;
+            double delta = static_cast<double>(x) - this->mean;
+            this->mean += delta/static_cast<double>(this->count);
+            this->m2   += delta*(static_cast<double>(x) - this->mean);
+        }
+
+        /**
+         * @brief Merges the statistics of a block into these ones.
+         * @param[in] other The statistics of the block.
+         */
+        void merge(const statistics& other)
+        {
+            this->nans += other.nans;
+            if (other.count == 0u)
+            {
+                return;
+            }
+            if (this->count == 0u)
+            {
+                std::size_t nans = this->nans;
+                *this = other;
+                this->nans = nans;
+                return;
+            }
+            double n1    = static_cast<double>(this->count);
+            double n2    = static_cast<double>(other.count);
+            double delta = other.mean - this->mean;
+            this->count += other.count;
+            this->mean  += delta*n2/(n1 + n2);
+            this->m2    += other.m2 + delta*delta*n1*n2/(n1 + n2);
+            this->min    = other.min < this->min ? other.min : this->min;
+            this->max    = other.max > this->max ? other.max : this->max;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Computes the statistics of a small block of contiguous numbers.
+     * Each pass works on independent lanes without any branch, so the compiler vectorizes it even without
+     * fast-math, and the block stays in cache for the second pass.
+     * @param[in] data The values, see contiguous_arithmetic::data().
+     * @param[in] n    The number of values.
+     * @return The statistics of the block.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T, typename Data>
+    ::mtl_details::statistics<T> block_statistics(const Data& data, std::size_t n)
+    {
+        const std::size_t lanes = 8u;
+        const T highest = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() :
+                                                                  std::numeric_limits<T>::max();
+        const T lowest  = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() :
+                                                                  std::numeric_limits<T>::lowest();
+        double      sums[lanes];
+        std::size_t valid[lanes];
+        T           mins[lanes];
+        T           maxs[lanes];
+        for(std::size_t l=0u;l<lanes;++l)
+        {
+            sums[l]  = 0.0;
+            valid[l] = 0u;
+            mins[l]  = highest;
+            maxs[l]  = lowest;
+        }
+        std::size_t i = 0u;
+        for(;i+lanes<=n;i+=lanes)
+        {
+            for(std::size_t l=0u;l<lanes;++l)
+            {
+                T x = data[i+l];
+                bool number = !::mtl_details::is_nan(x);
+                sums[l]  += number ? static_cast<double>(x) : 0.0;
+                valid[l] += number;
+                mins[l]   = x < mins[l] ? x : mins[l];
+                maxs[l]   = x > maxs[l] ? x : maxs[l];
+            }
+        }
+        for(;i<n;++i)
+        {
+            T x = data[i];
+            bool number = !::mtl_details::is_nan(x);
+            sums[0]  += number ? static_cast<double>(x) : 0.0;
+            valid[0] += number;
+            mins[0]   = x < mins[0] ? x : mins[0];
+            maxs[0]   = x > maxs[0] ? x : maxs[0];
+        }
+        ::mtl_details::statistics<T> result;
+        double sum = 0.0;
+        result.min = highest;
+        result.max = lowest;
+        for(std::size_t l=0u;l<lanes;++l)
+        {
+            sum          += sums[l];
+            result.count += valid[l];
+            result.min    = mins[l] < result.min ? mins[l] : result.min;
+            result.max    = maxs[l] > result.max ? maxs[l] : result.max;
+        }
+        result.nans = n - result.count;
+        if (result.count == 0u)
+        {
+            return result;
+        }
+        result.mean = sum/static_cast<double>(result.count);
+        double squares[lanes];
+        for(std::size_t l=0u;l<lanes;++l)
+        {
+            squares[l] = 0.0;
+        }
+        for(i=0u;i+lanes<=n;i+=lanes)
+        {
+            for(std::size_t l=0u;l<lanes;++l)
+            {
+                T x = data[i+l];
+                double d = ::mtl_details::is_nan(x) ? 0.0 : static_cast<double>(x) - result.mean;
+                squares[l] += d*d;
+            }
+        }
+        for(;i<n;++i)
+        {
+            double d = ::mtl_details::is_nan(data[i]) ? 0.0 : static_cast<double>(data[i]) - result.mean;
+            squares[0] += d*d;
+        }
+        for(std::size_t l=0u;l<lanes;++l)
+        {
+            result.m2 += squares[l];
+        }
+        return result;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Computes the statistics of any range, one element at a time.
+     * @param[in]      first  The first element.
+     * @param[in]      last   The end of the range.
+     * @param[in,out]  sketch The 3 percentile estimators to update, or nullptr.
+     * @param[useless]        Isn't use at all, just here to select this function.
+     * @return The statistics of [first, last).
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T, typename Iterator>
+    ::mtl_details::statistics<T> range_statistics(Iterator first, Iterator last,
+                                                  ::mtl_details::p2_quantile* sketch, ::mtl_details::Int<0u>)
+    {
+        ::mtl_details::statistics<T> result;
+        for(;first != last;++first)
+        {
+            T x = *first;
+            result.add(x);
+            if (sketch != nullptr && !::mtl_details::is_nan(x))
+            {
+                for(std::size_t i=0u;i<3u;++i)
+                {
+                    sketch[i].add(static_cast<double>(x));
+                }
+            }
+        }
+        return result;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Computes the statistics of contiguous numbers, block by block.
+     * Percentiles need every element in order, so they are left to the generic version.
+     * @param[in]      first  The first element.
+     * @param[in]      last   The end of the range.
+     * @param[in,out]  sketch The 3 percentile estimators to update, or nullptr.
+     * @param[useless]        Isn't use at all, just here to select this function.
+     * @return The statistics of [first, last).
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T, typename Iterator>
+    ::mtl_details::statistics<T> range_statistics(Iterator first, Iterator last,
+                                                  ::mtl_details::p2_quantile* sketch, ::mtl_details::Int<1u>)
+    {
+        if (sketch != nullptr || first == last)
+        {
+            return ::mtl_details::range_statistics<T>(first, last, sketch, ::mtl_details::Int<0u>());
+        }
+        const std::size_t block = 256u;
+        auto data = ::mtl_details::contiguous_arithmetic<Iterator>::data(first);
+        std::size_t n = ::mtl_details::contiguous_arithmetic<Iterator>::distance(first, last);
+        ::mtl_details::statistics<T> result;
+        for(std::size_t i=0u;i<n;i+=block)
+        {
+            result.merge(::mtl_details::block_statistics<T>(data + i, n - i < block ? n - i : block));
+        }
+        return result;
+    }
+}
+
+namespace mtl
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class summary_view
+     * @brief A non owning view which displays statistics about a range of numbers instead of its elements.
+     * @tparam Container The container you wanna summarize.
+     * @warning The container must outlive the view.
+     */
+    template<typename Container>
+    class summary_view final
+    {
+        private:
+            typedef typename ::mtl_details::iterator_of<Container>::type Iterator;
+            typedef typename std::decay<decltype(*std::declval<Iterator>())>::type T;
+            static_assert(std::is_arithmetic<T>::value, "mtl::summary() requires a range of numbers");
+
+            ::mtl_details::view_storage<Container> container;
+            bool                                   percentiles;
+        public:
+            /**
+             * @brief Creates a summary of @b c.
+             * @param[in] c         The summarized container.
+             * @param[in] quantiles Also displays approximated p50, p90 and p99.
+             */
+            summary_view(const Container& c, bool quantiles) : container(c), percentiles(quantiles)
+            {
+            }
+
+            /**
+             * @brief Computes and displays the summary in a single pass.
+             * The standard deviation is the population one.
+             * @param[in,out] out  The output stream you wanna use.
+             * @param[in]     view The summary to display.
+             * @return @b out
+             */
+            friend std::ostream& operator<<(std::ostream& out, const summary_view& view)
+            {
+                ::mtl_details::p2_quantile sketch[3] = {::mtl_details::p2_quantile(0.5),
+                                                        ::mtl_details::p2_quantile(0.9),
+                                                        ::mtl_details::p2_quantile(0.99)};
+                ::mtl_details::statistics<T> stats = ::mtl_details::range_statistics<T>(
+                    begin(view.container.get()), end(view.container.get()), view.percentiles ? sketch : nullptr,
+                    ::mtl_details::Int<::mtl_details::contiguous_arithmetic<Iterator>::value>());
+                out << "{ count=" << stats.count;
+                if (stats.count != 0u)
+                {
+                    out << " min=" << +stats.min << " max=" << +stats.max << " mean=" << stats.mean
+                        << " stddev=" << std::sqrt(stats.m2/static_cast<double>(stats.count));
+                }
+                out << " nan=" << stats.nans;
+                if (view.percentiles && stats.count != 0u)
+                {
+                    out << " p50=" << sketch[0].value() << " p90=" << sketch[1].value()
+                        << " p99=" << sketch[2].value();
+                }
+                return out << " }";
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays count, min, max, mean, standard deviation and NaN count of @b c instead of its elements.
+     * @param[in] c           The container of numbers you wanna summarize.
+     * @param[in] percentiles Also displays approximated p50, p90 and p99 (computed in constant memory).
+     * @return The view, which could be sent to a std::ostream.
+     *
+     * Usage :
+     * @code
+     * std::vector<double> v = {1.0, 2.0, 3.0, 4.0, 5.0};
+     * std::cout << mtl::summary(v) << std::endl;
+     * // Output : { count=5 min=1 max=5 mean=3 stddev=1.41421 nan=0 }
+     * @endcode
+     */
+    template<typename Container>
+    summary_view<Container> summary(const Container& c, bool percentiles = false)
+    {
+        return summary_view<Container>(c, percentiles);
+    }
+}
+
+namespace mtl_details
+{
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class range_printed
+     * @brief Sets @b value to true if operator<< displays @b T element by element between brackets.
+     * std::basic_string, char arrays and tuples (std::array included) are displayed differently.
+     * @tparam T The type you wanna test.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T>
+    struct range_printed final
+    {
+        enum : std::size_t {value = 0u};
+        MTL_UNCREATABLE(range_printed);
+    };
+    template<template<typename...> class Container, typename... Types>
+    struct range_printed<Container<Types...>> final
+    {
+        enum : std::size_t
+        {
+            value = ::mtl_details::has_iterators<Container<Types...>>::value &&
+                    !::mtl_details::is_tuplable<Container<Types...>>::value
+        };
+        MTL_UNCREATABLE(range_printed);
+    };
+    template<typename... Types>
+    struct range_printed<std::basic_string<Types...>> final
+    {
+        enum : std::size_t {value = 0u};
+        MTL_UNCREATABLE(range_printed);
+    };
+    template<typename T, std::size_t N>
+    struct range_printed<T[N]> final
+    {
+        enum : std::size_t
+        {
+            value = !std::is_same<T, char>::value && !std::is_same<T, signed char>::value &&
+                    !std::is_same<T, unsigned char>::value && !std::is_same<T, wchar_t>::value
+        };
+        MTL_UNCREATABLE(range_printed);
+    };
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class window_buffer
+     * @brief A stream buffer which copies a window of what it receives into a caller provided buffer.
+     * The first @b skip characters are dropped, then characters are copied until the buffer is full, the
+     * remaining ones are dropped too. It never allocates.
+     * @warning You shall not use this class by yourself.
+     */
+    class window_buffer final : public std::streambuf
+    {
+        private:
+            char*       data;
+            std::size_t capacity;
+            std::size_t kept;
+            std::size_t skip;
+            bool        overflowed;
+
+            void store(const char* s, std::size_t n)
+            {
+                std::size_t skipped = n < this->skip ? n : this->skip;
+                this->skip -= skipped;
+                s += skipped;
+                n -= skipped;
+                std::size_t room = this->capacity - this->kept;
+                std::size_t copied = n < room ? n : room;
+                std::memcpy(this->data + this->kept, s, copied);
+                this->kept += copied;
+                this->overflowed = this->overflowed || copied != n;
+            }
+        protected:
+            std::streamsize xsputn(const char* s, std::streamsize n) override
+            {
+                this->store(s, static_cast<std::size_t>(n));
+                return n;
+            }
+            int_type overflow(int_type c) override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                {
+                    char character = traits_type::to_char_type(c);
+                    this->store(&character, 1u);
+                }
+                return traits_type::not_eof(c);
+            }
+        public:
+            /**
+             * @brief Creates a window on @b size characters starting at @b target.
+             * @param[out] target Where characters are copied.
+             * @param[in]  size   The size of @b target.
+             */
+            window_buffer(char* target, std::size_t size) : std::streambuf(), data(target), capacity(size),
+                kept(0u), skip(0u), overflowed(false)
+            {
+            }
+            /**
+             * @brief Starts a new item, whose first @b delivered characters have already been copied before.
+             * @param[in] delivered The number of characters to drop.
+             */
+            void start(std::size_t delivered)
+            {
+                this->skip       = delivered;
+                this->overflowed = false;
+            }
+            //! @return The number of characters copied so far.
+            std::size_t size(void) const
+            {
+                return this->kept;
+            }
+            //! @return true if the current item didn't fit.
+            bool truncated(void) const
+            {
+                return this->overflowed;
+            }
+            //! @return true if nothing more could be copied.
+            bool full(void) const
+            {
+                return this->kept == this->capacity;
+            }
+            /**
+             * @brief Copies as much of @b n characters starting at @b s as possible.
+             * @param[in] s The characters.
+             * @param[in] n The number of characters.
+             * @return The number of copied characters.
+             */
+            std::size_t copy(const char* s, std::size_t n)
+            {
+                std::size_t before = this->kept;
+                this->start(0u);
+                this->store(s, n);
+                return this->kept - before;
+            }
+            /**
+             * @brief Writes what @b format writes into @b out, without the @b delivered characters already
+             * copied by a previous call.
+             * @param[in,out] out       The stream writing into this buffer.
+             * @param[in,out] delivered The characters already copied, updated if it doesn't fit.
+             * @param[in]     format    Writes the item into a stream.
+             * @return true if everything has been copied.
+             */
+            template<typename Format>
+            bool resume(std::ostream& out, std::size_t& delivered, const Format& format)
+            {
+                std::size_t before = this->kept;
+                this->start(delivered);
+                format(out);
+                if (this->overflowed)
+                {
+                    delivered += this->kept - before;
+                    return false;
+                }
+                delivered = 0u;
+                return true;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class chunk_kind
+     * @brief Chooses how mtl::chunked_formatter produces @b T : 1 for ranges ("[ " elements "]"), 2 for
+     * std::array ("( " elements ")"), which are both resumed element by element, and 0 for anything else,
+     * which is formatted as a whole.
+     * @tparam T         The type you wanna display.
+     * @tparam Reference How @b T is reached, elements which aren't lvalues can't be walked through later.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T, typename Reference = const T&>
+    struct chunk_kind final
+    {
+        enum : std::size_t
+        {
+            value = std::is_lvalue_reference<Reference>::value && ::mtl_details::range_printed<T>::value ? 1u : 0u
+        };
+        MTL_UNCREATABLE(chunk_kind);
+    };
+    template<typename T, std::size_t N, typename Reference>
+    struct chunk_kind<std::array<T, N>, Reference> final
+    {
+        enum : std::size_t {value = std::is_lvalue_reference<Reference>::value ? 2u : 0u};
+        MTL_UNCREATABLE(chunk_kind);
+    };
+    //! @}
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class chunk_leaf
+     * @brief Produces something which is formatted as a whole (a number, a string, a tuple...) in chunks.
+     * When it doesn't fit, it is formatted again by the next call, and its already delivered characters are
+     * skipped. If it still doesn't fit (it is bigger than a chunk), it is formatted once more into memory,
+     * and the next calls only copy it, so the cost stays linear.
+     * @warning You shall not use this class by yourself.
+     */
+    class chunk_leaf final
+    {
+        private:
+            std::size_t delivered;
+            std::size_t attempts;
+            std::string spill;
+        public:
+            chunk_leaf(void) : delivered(0u), attempts(0u), spill()
+            {
+            }
+            /**
+             * @brief Writes the next characters of the item written by @b format.
+             * @param[in,out] out    The stream writing into @b buffer.
+             * @param[in,out] buffer The destination.
+             * @param[in]     format Writes the item into a stream, it must write the same thing each time.
+             * @return true once the whole item has been written.
+             */
+            template<typename Format>
+            bool next(std::ostream& out, ::mtl_details::window_buffer& buffer, const Format& format)
+            {
+                if (!this->spill.empty())
+                {
+                    this->delivered += buffer.copy(this->spill.data() + this->delivered,
+                                                   this->spill.size() - this->delivered);
+                    if (this->delivered != this->spill.size())
+                    {
+                        return false;
+                    }
+                    std::string().swap(this->spill);
+                    this->delivered = 0u;
+                    this->attempts  = 0u;
+                    return true;
+                }
+                if (buffer.resume(out, this->delivered, format))
+                {
+                    this->attempts = 0u;
+                    return true;
+                }
+                if (++this->attempts >= 2u)
+                {
+                    std::ostringstream whole;
+                    whole.copyfmt(out);
+                    format(whole);
+                    this->spill = whole.str();
+                }
+                return false;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! @{
+    /**
+     * @class chunk_cursor
+     * @brief Remembers where mtl::chunked_formatter stopped inside @b T.
+     * Ranges hold an iterator and the cursor of their current element, so nested ranges are resumed where
+     * they stopped too.
+     * @tparam T    The displayed type.
+     * @tparam Kind See chunk_kind.
+     * @warning You shall not use this class by yourself.
+     */
+    template<typename T, std::size_t Kind = ::mtl_details::chunk_kind<T>::value>
+    class chunk_cursor;
+    //! @brief Formatted as a whole case.
+    template<typename T>
+    class chunk_cursor<T, 0u> final
+    {
+        private:
+            const T*                  value;
+            ::mtl_details::chunk_leaf leaf;
+        public:
+            chunk_cursor(void) : value(nullptr), leaf()
+            {
+            }
+            void reset(const T& v)
+            {
+                this->value = &v;
+            }
+            bool next(std::ostream& out, ::mtl_details::window_buffer& buffer)
+            {
+                const T& v = *this->value;
+                return this->leaf.next(out, buffer, [&v](std::ostream& o){ o << v; });
+            }
+    };
+    //! @brief Range and std::array case, elements are produced one by one, or run by run in run-length mode.
+    template<typename T, std::size_t Kind>
+    class chunk_cursor final
+    {
+        private:
+            typedef typename ::mtl_details::iterator_of<T>::type                  Iterator;
+            typedef decltype(*std::declval<Iterator>())                           Reference;
+            typedef typename std::decay<Reference>::type                          Element;
+            typedef ::mtl_details::chunk_cursor<Element,
+                        ::mtl_details::chunk_kind<Element, Reference>::value>     Child;
+            enum class step {opening, element, count, separator, closing, done};
+
+            Iterator                  current;
+            Iterator                  last;
+            step                      state;
+            std::size_t               delivered; // The characters of the current piece already written.
+            std::size_t               run;       // The length of the collapsed run being written, or 0.
+            std::size_t               plain;     // The elements left before looking for a run again.
+            bool                      compact;   // Bits in bitstring mode, without any separator.
+            bool                      any;
+            Child                     child;
+            ::mtl_details::chunk_leaf leaf;
+
+            bool piece(std::ostream& out, ::mtl_details::window_buffer& buffer, const char* text)
+            {
+                return buffer.resume(out, this->delivered, [text](std::ostream& o){ o << text; });
+            }
+            void start(Reference element, ::mtl_details::Int<0u>)
+            {
+                (void)element;
+            }
+            template<std::size_t K>
+            void start(Reference element, ::mtl_details::Int<K>)
+            {
+                this->child.reset(element);
+            }
+            bool produce(std::ostream& out, ::mtl_details::window_buffer& buffer, ::mtl_details::Int<0u>)
+            {
+                const Iterator& it = this->current;
+                return this->leaf.next(out, buffer, [&it](std::ostream& o){ o << *it; });
+            }
+            template<std::size_t K>
+            bool produce(std::ostream& out, ::mtl_details::window_buffer& buffer, ::mtl_details::Int<K>)
+            {
+                return this->child.next(out, buffer);
+            }
+            void find_run(std::size_t min_run, ::mtl_details::Int<1u>)
+            {
+                Iterator next = this->current;
+                std::size_t count = 1u;
+                for(++next;next != this->last && *next == *this->current;++next)
+                {
+                    ++count;
+                }
+                if (count >= min_run)
+                {
+                    this->run = count;
+                }
+                else
+                {
+                    this->plain = count;
+                }
+            }
+            void find_run(std::size_t, ::mtl_details::Int<0u>)
+            {
+            }
+            void begin_element(std::ostream& out)
+            {
+                if (!(this->current != this->last))
+                {
+                    this->state = step::closing;
+                    return;
+                }
+                this->any = true;
+                this->run = 0u;
+                std::size_t min_run = static_cast<std::size_t>(out.iword(::mtl_details::run_length_index()));
+                if (this->plain != 0u)
+                {
+                    --this->plain;
+                }
+                else if (min_run > 1u)
+                {
+                    this->find_run(min_run, ::mtl_details::Int<::mtl_details::equality_comparable<Reference>::value &&
+                                                                ::mtl_details::multi_pass<Iterator>::value>());
+                    this->plain -= this->plain != 0u ? 1u : 0u;
+                }
+                this->start(*this->current, ::mtl_details::Int<::mtl_details::chunk_kind<Element, Reference>::value>());
+                this->state = step::element;
+            }
+        public:
+            chunk_cursor(void) : current(), last(), state(step::done), delivered(0u), run(0u), plain(0u),
+                compact(false), any(false), child(), leaf()
+            {
+            }
+            void reset(const T& c)
+            {
+                this->current   = begin(c);
+                this->last      = end(c);
+                this->state     = step::opening;
+                this->delivered = 0u;
+                this->run       = 0u;
+                this->plain     = 0u;
+                this->any       = false;
+            }
+            bool next(std::ostream& out, ::mtl_details::window_buffer& buffer)
+            {
+                while(!buffer.full() || this->state == step::done)
+                {
+                    switch(this->state)
+                    {
+                        case step::opening:
+                            if (!this->piece(out, buffer, Kind == 2u ? "( " : "[ "))
+                            {
+                                return false;
+                            }
+                            this->compact = ::mtl_details::traversal<Iterator>::value == 3u &&
+                                            out.iword(::mtl_details::bitstring_index()) != 0 &&
+                                            out.iword(::mtl_details::run_length_index()) <= 1 &&
+                                            ::mtl_details::bit_words_allowed(out);
+                            this->begin_element(out);
+                            break;
+                        case step::element:
+                            if (!this->produce(out, buffer,
+                                               ::mtl_details::Int<::mtl_details::chunk_kind<Element, Reference>::value>()))
+                            {
+                                return false;
+                            }
+                            this->state = this->run != 0u ? step::count : step::separator;
+                            break;
+                        case step::count:
+                        {
+                            const std::size_t count = this->run;
+                            if (!buffer.resume(out, this->delivered, [count](std::ostream& o)
+                                {
+                                    ::mtl_details::print_run_count(o, count);
+                                }))
+                            {
+                                return false;
+                            }
+                            for(;this->run != 0u;--this->run)
+                            {
+                                ++this->current;
+                            }
+                            this->begin_element(out);
+                            break;
+                        }
+                        case step::separator:
+                            if (!this->compact && !this->piece(out, buffer, " "))
+                            {
+                                return false;
+                            }
+                            ++this->current;
+                            this->begin_element(out);
+                            break;
+                        case step::closing:
+                            if (!this->piece(out, buffer, Kind == 2u ? ")" : this->compact && this->any ? " ]" : "]"))
+                            {
+                                return false;
+                            }
+                            this->state = step::done;
+                            break;
+                        case step::done:
+                            return true;
+                    }
+                }
+                return false;
+            }
+    };
+    //! @}
+}
+
+namespace mtl
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class chunked_formatter
+     * @brief A resumable formatter which writes the display of a container chunk by chunk into your buffers.
+     * It is a state machine which remembers where it stopped, so you could interleave formatting with
+     * something else (such as waiting for a non-blocking socket), with a bounded memory usage.
+     *
+     * Ranges and std::array are produced element by element, nested ones included, and resume exactly where
+     * they stopped. Anything else (numbers, strings, tuples, summaries...) is formatted as a whole : when
+     * it doesn't fit, it is formatted again by the next call, and when it is bigger than a chunk it is kept
+     * in memory until it has been delivered.
+     *
+     * @tparam Container The container you wanna display.
+     * @warning The container must outlive the formatter, and mustn't change in between.
+     */
+    template<typename Container>
+    class chunked_formatter final
+    {
+        private:
+            ::mtl_details::chunk_cursor<Container> cursor;
+            bool                                   finished;
+            std::ios_base::fmtflags                flags;
+            std::streamsize                        precision;
+            char                                   fill;
+            std::locale                            locale;
+            long                                   min_run;
+            long                                   bitstring;
+        public:
+            /**
+             * @brief Creates a formatter for @b c, with default formatting flags.
+             * @param[in] c The container you wanna display.
+             */
+            explicit chunked_formatter(const Container& c) : cursor(), finished(false),
+                flags(std::ios_base::skipws | std::ios_base::dec), precision(6), fill(' '), locale(), min_run(0),
+                bitstring(0)
+            {
+                this->cursor.reset(c);
+            }
+
+            /**
+             * @brief Creates a formatter for @b c, using the flags, precision, fill, locale, run-length and
+             * bitstring modes of @b model.
+             * @param[in] c      The container you wanna display.
+             * @param[in] model  The stream whose formatting you wanna use.
+             */
+            chunked_formatter(const Container& c, std::ostream& model) : chunked_formatter(c)
+            {
+                this->flags     = model.flags();
+                this->precision = model.precision();
+                this->fill      = model.fill();
+                this->locale    = model.getloc();
+                this->min_run   = model.iword(::mtl_details::run_length_index());
+                this->bitstring = model.iword(::mtl_details::bitstring_index());
+            }
+
+            /**
+             * @brief Formats the next characters into @b target.
+             * @param[out] target Where to write.
+             * @param[in]  size   The size of @b target.
+             * @return The number of written characters, 0 only when everything has been written (or @b size is 0).
+             */
+            std::size_t next(char* target, std::size_t size)
+            {
+                if (this->finished || size == 0u)
+                {
+                    return 0u;
+                }
+                ::mtl_details::window_buffer buffer(target, size);
+                std::ostream out(&buffer);
+                out.flags(this->flags);
+                out.precision(this->precision);
+                out.fill(this->fill);
+                out.imbue(this->locale);
+                out.iword(::mtl_details::run_length_index()) = this->min_run;
+                out.iword(::mtl_details::bitstring_index())  = this->bitstring;
+                this->finished = this->cursor.next(out, buffer);
+                return buffer.size();
+            }
+
+            //! @return true once everything has been written.
+            bool done(void) const
+            {
+                return this->finished;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Creates a resumable formatter for @b c.
+     * @param[in] c The container you wanna display.
+     * @return The formatter.
+     *
+     * Usage :
+     * @code
+     * auto formatter = mtl::chunked(v);
+     * char buffer[4096];
+     * while(std::size_t n = formatter.next(buffer, sizeof(buffer)))
+     * {
+     *     // Wait until fd is writable, then write(fd, buffer, n).
+     * }
+     * @endcode
+     */
+    template<typename Container>
+    chunked_formatter<Container> chunked(const Container& c)
+    {
+        return chunked_formatter<Container>(c);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Creates a resumable formatter for @b c, using the formatting of @b model.
+     * @param[in] c      The container you wanna display.
+     * @param[in] model  The stream whose flags, precision, fill, locale, run-length and bitstring modes are used.
+     * @return The formatter.
+     */
+    template<typename Container>
+    chunked_formatter<Container> chunked(const Container& c, std::ostream& model)
+    {
+        return chunked_formatter<Container>(c, model);
+    }
+
+    //! @{
+    //! @brief The formatter outlives the statement, so a temporary (such as a view) would dangle.
+    template<typename Container>
+    void chunked(const Container&& c) = delete;
+    template<typename Container>
+    void chunked(const Container&& c, std::ostream& model) = delete;
+    //! @}
+}
+
+namespace mtl_details
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class format_arena
+     * @brief A growable stream buffer, reused from one call of mtl::to_string_view() to the next.
+     * It grows geometrically, and gives back memory once the texts have been much smaller than it for
+     * MTL_FORMAT_ARENA_IDLE calls in a row, so once warmed up a steady workload never allocates.
+     * @warning You shall not use this class by yourself.
+     */
+    class format_arena final : public std::streambuf
+    {
+        private:
+            std::unique_ptr<char[]> storage;
+            std::size_t             capacity;
+            std::size_t             peak; // The biggest text since the buffer is idle.
+            std::size_t             idle; // The number of calls in a row using less than a quarter of it.
+
+            void move_to(std::size_t used)
+            {
+                this->setp(this->storage.get(), this->storage.get() + this->capacity);
+                this->forward(used);
+            }
+            void forward(std::size_t n)
+            {
+                // pbump() only takes an int.
+                for(;n > 0u;)
+                {
+                    std::size_t step = n < static_cast<std::size_t>(std::numeric_limits<int>::max()) ?
+                                       n : static_cast<std::size_t>(std::numeric_limits<int>::max());
+                    this->pbump(static_cast<int>(step));
+                    n -= step;
+                }
+            }
+            void resize(std::size_t wanted, std::size_t used)
+            {
+                std::unique_ptr<char[]> other(new char[wanted]);
+                if (used != 0u)
+                {
+                    std::memcpy(other.get(), this->pbase(), used);
+                }
+                this->storage  = std::move(other);
+                this->capacity = wanted;
+                this->move_to(used);
+            }
+            void reserve(std::size_t extra)
+            {
+                std::size_t used = this->size();
+                if (this->capacity - used >= extra)
+                {
+                    return;
+                }
+                std::size_t wanted = this->capacity == 0u ? MTL_FORMAT_ARENA_MIN : this->capacity;
+                for(;wanted - used < extra;)
+                {
+                    wanted *= 2u;
+                }
+                this->resize(wanted, used);
+            }
+        protected:
+            std::streamsize xsputn(const char* s, std::streamsize n) override
+            {
+                this->reserve(static_cast<std::size_t>(n));
+                std::memcpy(this->pptr(), s, static_cast<std::size_t>(n));
+                this->forward(static_cast<std::size_t>(n));
+                return n;
+            }
+            int_type overflow(int_type c) override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                {
+                    this->reserve(1u);
+                    *this->pptr() = traits_type::to_char_type(c);
+                    this->pbump(1);
+                }
+                return traits_type::not_eof(c);
+            }
+        public:
+            format_arena(void) : std::streambuf(), storage(), capacity(0u), peak(0u), idle(0u)
+            {
+            }
+            /**
+             * @brief Forgets the previous text, and shrinks the buffer if it has been idle for too long.
+             */
+            void rewind(void)
+            {
+                std::size_t used = this->size();
+                if (used > this->capacity/4u)
+                {
+                    this->idle = 0u;
+                    this->peak = 0u;
+                }
+                else
+                {
+                    this->peak = used > this->peak ? used : this->peak;
+                    if (++this->idle >= MTL_FORMAT_ARENA_IDLE)
+                    {
+                        std::size_t wanted = MTL_FORMAT_ARENA_MIN;
+                        for(;wanted < 2u*this->peak;)
+                        {
+                            wanted *= 2u;
+                        }
+                        if (wanted < this->capacity)
+                        {
+                            this->resize(wanted, 0u);
+                        }
+                        this->idle = 0u;
+                        this->peak = 0u;
+                    }
+                }
+                this->move_to(0u);
+            }
+            //! @return The beginning of the text.
+            const char* data(void) const
+            {
+                return this->pbase();
+            }
+            //! @return The size of the text.
+            std::size_t size(void) const
+            {
+                return static_cast<std::size_t>(this->pptr() - this->pbase());
+            }
+            //! @return The size of the buffer.
+            std::size_t reserved(void) const
+            {
+                return this->capacity;
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class format_context
+     * @brief The arena and the stream writing into it, one per thread.
+     * @warning You shall not use this class by yourself.
+     */
+    struct format_context final
+    {
+        format_arena buffer; //!< Where the texts are written.
+        std::ostream stream; //!< The stream writing into @b buffer.
+        bool         busy;   //!< true while a text is written, to detect reentrant calls.
+
+        format_context(void) : buffer(), stream(&this->buffer), busy(false)
+        {
+            // A failed allocation must reach the caller, not only set badbit.
+            this->stream.exceptions(std::ios_base::badbit);
+        }
+
+        //! @return The context of the calling thread.
+        static format_context& local(void)
+        {
+            static thread_local format_context context;
+            return context;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @class busy_guard
+     * @brief Marks a format_context as used until the end of the scope, even if formatting throws.
+     * @warning You shall not use this class by yourself.
+     */
+    class busy_guard final
+    {
+        private:
+            bool& busy;
+        public:
+            explicit busy_guard(bool& flag) : busy(flag)
+            {
+                this->busy = true;
+            }
+            ~busy_guard(void)
+            {
+                this->busy = false;
+            }
+            busy_guard(const busy_guard&) = delete;
+            busy_guard& operator=(const busy_guard&) = delete;
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Gives @b out the formatting of @b model, or the default formatting of a new stream.
+     * The run-length and bitstring modes are reset too, since the stream is reused from one call to the next.
+     * @param[in,out] out   The stream to set up.
+     * @param[in]     model The stream whose flags, precision, fill, locale and modes are used, may be nullptr.
+     * @warning You shall not use this function by yourself.
+     */
+    inline void copy_format(std::ostream& out, std::ostream* model)
+    {
+        out.clear();
+        out.width(0);
+        if (model == nullptr)
+        {
+            out.flags(std::ios_base::skipws | std::ios_base::dec);
+            out.precision(6);
+            out.fill(' ');
+            out.imbue(std::locale());
+            out.iword(::mtl_details::run_length_index()) = 0;
+            out.iword(::mtl_details::bitstring_index())  = 0;
+            return;
+        }
+        out.flags(model->flags());
+        out.precision(model->precision());
+        out.fill(model->fill());
+        out.imbue(model->getloc());
+        out.iword(::mtl_details::run_length_index()) = model->iword(::mtl_details::run_length_index());
+        out.iword(::mtl_details::bitstring_index())  = model->iword(::mtl_details::bitstring_index());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Writes @b value into the arena of the calling thread.
+     * @param[in] context The context of the calling thread, which mustn't be busy.
+     * @param[in] value   The value you wanna display.
+     * @param[in] model   The stream whose formatting is used, may be nullptr.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    void format_local(format_context& context, const T& value, std::ostream* model)
+    {
+        ::mtl_details::busy_guard guard(context.busy);
+        ::mtl_details::copy_format(context.stream, model);
+        context.buffer.rewind();
+        context.stream << value;
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into a new std::string.
+     * The arena of the calling thread is used, unless it is already busy (a nested call).
+     * @param[in] value The value you wanna display.
+     * @param[in] model The stream whose formatting is used, may be nullptr.
+     * @return The text.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    std::string format_string(const T& value, std::ostream* model)
+    {
+        ::mtl_details::format_context& context = ::mtl_details::format_context::local();
+        if (context.busy)
+        {
+            std::ostringstream out;
+            ::mtl_details::copy_format(out, model);
+            out << value;
+            return out.str();
+        }
+        ::mtl_details::format_local(context, value, model);
+        return std::string(context.buffer.data(), context.buffer.size());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into the arena of the calling thread.
+     * @param[in] value The value you wanna display.
+     * @param[in] model The stream whose formatting is used, may be nullptr.
+     * @return The context holding the text.
+     * @throw std::runtime_error If it is called while displaying an other value on the same thread.
+     * @warning You shall not use this function by yourself.
+     */
+    template<typename T>
+    const format_context& format_view(const T& value, std::ostream* model)
+    {
+        ::mtl_details::format_context& context = ::mtl_details::format_context::local();
+        if (context.busy)
+        {
+            throw std::runtime_error("mtl::to_string_view() can't be called while displaying a value !");
+        }
+        ::mtl_details::format_local(context, value, model);
+        return context;
+    }
+}
+
+namespace mtl
+{
+    //-----------------------------------------------------------------------------
+    /**
+     * @class text_view
+     * @brief A non owning view on a text, like std::string_view (which it converts to, in C++17).
+     */
+    class text_view final
+    {
+        private:
+            const char* first;
+            std::size_t length;
+        public:
+            /**
+             * @brief Creates a view on @b n characters starting at @b s.
+             * @param[in] s The first character.
+             * @param[in] n The number of characters.
+             */
+            text_view(const char* s, std::size_t n) : first(s), length(n)
+            {
+            }
+            //! @return The first character, the text isn't null terminated.
+            const char* data(void) const
+            {
+                return this->first;
+            }
+            //! @return The number of characters.
+            std::size_t size(void) const
+            {
+                return this->length;
+            }
+            //! @return true if the text is empty.
+            bool empty(void) const
+            {
+                return this->length == 0u;
+            }
+            //! @{
+            //! @brief Iterators on the characters.
+            const char* begin(void) const
+            {
+                return this->first;
+            }
+            const char* end(void) const
+            {
+                return this->first + this->length;
+            }
+            //! @}
+            //! @return A copy of the text.
+            std::string str(void) const
+            {
+                return std::string(this->first, this->length);
+            }
+#if __cplusplus >= 201703L
+            //! @return The same text as a std::string_view.
+            operator std::string_view(void) const
+            {
+                return std::string_view(this->first, this->length);
+            }
+#endif
+            /**
+             * @brief Writes the text.
+             * @param[in,out] out  The output stream you wanna use.
+             * @param[in]     text The text to write.
+             * @return @b out
+             */
+            friend std::ostream& operator<<(std::ostream& out, const text_view& text)
+            {
+                return out.write(text.first, static_cast<std::streamsize>(text.length));
+            }
+    };
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into a buffer owned by the calling thread, with the default formatting.
+     * The buffer is reused by each call, so once warmed up it doesn't allocate any memory.
+     * @param[in] value The value you wanna display.
+     * @return A view on the text.
+     * @throw std::runtime_error If it is called from an operator<< which is displayed by it.
+     * @warning The view is only valid until the next call of mtl::to_string_view() or mtl::to_string() on
+     * the same thread. Use mtl::to_string() to keep the text.
+     *
+     * Usage :
+     * @code
+     * std::vector<int> v = {1, 2, 3};
+     * mtl::text_view text = mtl::to_string_view(v);
+     * write(fd, text.data(), text.size());
+     * // Sends : [ 1 2 3 ]
+     * @endcode
+     */
+    template<typename T>
+    text_view to_string_view(const T& value)
+    {
+        const ::mtl_details::format_context& context = ::mtl_details::format_view(value, nullptr);
+        return text_view(context.buffer.data(), context.buffer.size());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into a buffer owned by the calling thread, with the formatting of @b model.
+     * @param[in] value The value you wanna display.
+     * @param[in] model The stream whose flags, precision, fill, locale, run-length and bitstring modes are used.
+     * @return A view on the text.
+     * @throw std::runtime_error If it is called from an operator<< which is displayed by it.
+     * @warning The view is only valid until the next call of mtl::to_string_view() or mtl::to_string() on
+     * the same thread.
+     */
+    template<typename T>
+    text_view to_string_view(const T& value, std::ostream& model)
+    {
+        const ::mtl_details::format_context& context = ::mtl_details::format_view(value, &model);
+        return text_view(context.buffer.data(), context.buffer.size());
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into a std::string, with the default formatting.
+     * The text is written in the buffer of the calling thread, then copied once into the returned string.
+     * @param[in] value The value you wanna display.
+     * @return The text, owned by the caller.
+     */
+    template<typename T>
+    std::string to_string(const T& value)
+    {
+        return ::mtl_details::format_string(value, nullptr);
+    }
+
+    //-----------------------------------------------------------------------------
+    /**
+     * @brief Displays @b value into a std::string, with the formatting of @b model.
+     * @param[in] value The value you wanna display.
+     * @param[in] model The stream whose flags, precision, fill, locale, run-length and bitstring modes are used.
+     * @return The text, owned by the caller.
+     */
+    template<typename T>
+    std::string to_string(const T& value, std::ostream& model)
+    {
+        return ::mtl_details::format_string(value, &model);
+    }
 }
 
 #undef MTL_IS_NOT_TUPLE
 #undef MTL_IS_TUPLE
+#undef MTL_PREFETCH
 #undef MTL_UNCREATABLE
 
 #endif
@@ -1,5 +1,6 @@
 #include <bits/stdc++.h> // Brute force includes
 
+#define MTL_ENABLE_MMAP
 #include "containers_ostream.hpp"
 
 
@@ -80,67 +81,79 @@ void testQueue(void)
 //-----------------------------------------------------------------------------
 void testList(void)
 {
-
+    std::list<int> l = {1, 2, 3};
+    COMPARE(l, "[ 1 2 3 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testForwardList(void)
 {
-
+    std::forward_list<int> fl = {4, 5, 6};
+    COMPARE(fl, "[ 4 5 6 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testDeque(void)
 {
-
+    std::deque<double> d = {1.5, 2.5};
+    d.push_front(0.5);
+    COMPARE(d, "[ 0.5 1.5 2.5 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testSet(void)
 {
-
+    std::set<int> s = {3, 1, 2};
+    COMPARE(s, "[ 1 2 3 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testUnorderedSet(void)
 {
-
+    std::unordered_set<int> s = {42};
+    COMPARE(s, "[ 42 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testUnorderedMap(void)
 {
-
+    std::unordered_map<int, std::string> m = {{1, "one"}};
+    COMPARE(m, "[ ( 1 one ) ]");
 }
 
 //-----------------------------------------------------------------------------
 void testValarray(void)
 {
-
+    std::valarray<int> v = {1, 2, 3};
+    COMPARE(v, "[ 1 2 3 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testMultiSet(void)
 {
-
+    std::multiset<int> s = {2, 1, 2};
+    COMPARE(s, "[ 1 2 2 ]");
 }
 
 //-----------------------------------------------------------------------------
 void testMultiMap(void)
 {
-
+    std::multimap<int, char> m = {{2, 'b'}, {1, 'a'}, {2, 'b'}};
+    COMPARE(m, "[ ( 1 a ) ( 2 b ) ( 2 b ) ]");
 }
 
 //-----------------------------------------------------------------------------
 void testUnorderedMultiMap(void)
 {
-
+    std::unordered_multimap<int, int> m = {{7, 7}, {7, 7}};
+    COMPARE(m, "[ ( 7 7 ) ( 7 7 ) ]");
 }
 
 //-----------------------------------------------------------------------------
 void testUnorderedMultiSet(void)
 {
-
+    std::unordered_multiset<int> s = {9, 9};
+    COMPARE(s, "[ 9 9 ]");
 }
 
 //-----------------------------------------------------------------------------
@@ -218,6 +231,439 @@ void testPair(void)
     COMPARE(p, "( 18 Hello world )");
 }
 
+//-----------------------------------------------------------------------------
+void testKeysValuesViews(void)
+{
+    std::map<int, float> m = {{1, 0.5f}, {2, 1.5f}, {3, 2.5f}};
+    COMPARE(mtl::keys(m), "[ 1 2 3 ]");
+    COMPARE(mtl::values(m), "[ 0.5 1.5 2.5 ]");
+}
+
+//-----------------------------------------------------------------------------
+void testProjectView(void)
+{
+    struct Point { float x; float y; };
+    std::vector<Point> points = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+    COMPARE(mtl::project(points, &Point::y), "[ 2 4 ]");
+    int arr[4] = {1, 2, 3, 4};
+    COMPARE(mtl::project(arr, [](int i){return i*i;}), "[ 1 4 9 16 ]");
+
+    // Data members of contiguous objects are read with a stride, they must display like a copy of them.
+    struct Sample { int id; double value; char tag; };
+    std::vector<Sample> samples;
+    std::vector<int> ids;
+    std::vector<double> values;
+    for(int i=0;i<600;++i)
+    {
+        samples.push_back({i / 70, 0.5*i, 'a'});
+        ids.push_back(samples.back().id);
+        values.push_back(samples.back().value);
+    }
+    std::stringstream oracle;
+    oracle << mtl::run_length(3) << ids;
+    COMPARE(mtl::run_length(3) << mtl::project(samples, &Sample::id), oracle.str());
+    oracle.str("");
+    oracle << mtl::summary(values);
+    COMPARE(mtl::summary(mtl::project(samples, &Sample::value)), oracle.str());
+}
+
+//-----------------------------------------------------------------------------
+void testFilterView(void)
+{
+    int arr[4] = {1, 2, 3, 4};
+    COMPARE(mtl::filter(arr, [](int i){return i%2 == 0;}), "[ 2 4 ]");
+    std::map<int, int> m = {{1, 1}, {2, 4}, {3, 9}};
+    COMPARE(mtl::filter(mtl::keys(m), [](int i){return i > 1;}), "[ 2 3 ]");
+
+    // A view of a temporary view keeps a copy of it, so it could be displayed later.
+    auto kept = mtl::filter(mtl::values(m), [](int i){return i > 1;});
+    COMPARE(kept, "[ 4 9 ]");
+    auto every = mtl::every(mtl::keys(m), 2);
+    COMPARE(every, "[ #0:1 #2:3 ]");
+    auto summary = mtl::summary(mtl::keys(m));
+    COMPARE(summary, "{ count=3 min=1 max=3 mean=2 stddev=0.816497 nan=0 }");
+}
+
+//-----------------------------------------------------------------------------
+void testMappedArray(void)
+{
+#ifdef MTL_HAS_MMAP
+    const float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    {
+        std::ofstream file("mapped_array_test.bin", std::ios::binary);
+        file.write(reinterpret_cast<const char*>(values), sizeof(values));
+    }
+    {
+        mapped_array<float> whole("mapped_array_test.bin");
+        COMPARE(whole, "[ 1 2 3 4 ]");
+        mapped_array<float> part("mapped_array_test.bin", sizeof(float), 2u);
+        COMPARE(part, "[ 2 3 ]");
+    }
+    bool thrown = false;
+    try
+    {
+        mapped_array<float> misaligned("mapped_array_test.bin", 1u);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    std::remove("mapped_array_test.bin");
+#endif
+}
+
+//-----------------------------------------------------------------------------
+struct GroupEveryDigit : public std::numpunct<char>
+{
+    std::string do_grouping(void) const override
+    {
+        return "\1";
+    }
+    char do_thousands_sep(void) const override
+    {
+        return ',';
+    }
+};
+
+//-----------------------------------------------------------------------------
+void testSmallTupleFormatting(void)
+{
+    std::array<float, 3> position = {{1.5f, -2.25f, 1e30f}};
+    COMPARE(position, "( 1.5 -2.25 1e+30 )");
+    COMPARE(std::scientific << position, "( 1.500000e+00 -2.250000e+00 1.000000e+30 )");
+    COMPARE(std::setprecision(2) << std::fixed << position,
+            "( 1.50 -2.25 1000000015047466219876688855040.00 )");
+    COMPARE(std::setw(4) << std::make_pair(1, 2), "  ( 1 2 )");
+    COMPARE(std::hex << std::make_tuple(short(-3), 255, 0.5), "( fffd ff 0.5 )");
+
+    // The longest integer : 22 octal digits, a base prefix and a separator between each digit.
+    std::stringstream grouped;
+    grouped.imbue(std::locale(grouped.getloc(), new GroupEveryDigit()));
+    grouped << std::oct << std::showbase;
+    std::array<unsigned long long, 1> biggest = {{~0ull}};
+    grouped << biggest;
+    CHECK(grouped.str() == "( 01,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7 )");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief A single pass range : all its iterators share the same read position, like std::istream_iterator.
+ */
+template<typename T>
+struct SinglePass
+{
+    struct iterator
+    {
+        typedef std::input_iterator_tag iterator_category;
+        typedef T                       value_type;
+        typedef std::ptrdiff_t          difference_type;
+        typedef const T*                pointer;
+        typedef const T&                reference;
+
+        const std::vector<T>* source;
+        std::size_t*          read;
+        bool                  end;
+
+        const T& operator*(void) const
+        {
+            return (*source)[*read];
+        }
+        iterator& operator++(void)
+        {
+            ++*read;
+            return *this;
+        }
+        bool operator==(const iterator& other) const
+        {
+            return (end || *read == source->size()) == (other.end || *other.read == other.source->size());
+        }
+        bool operator!=(const iterator& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    std::vector<T> values;
+    std::size_t    read;
+
+    friend iterator begin(const SinglePass& range)
+    {
+        return iterator{&range.values, const_cast<std::size_t*>(&range.read), false};
+    }
+    friend iterator end(const SinglePass& range)
+    {
+        return iterator{&range.values, const_cast<std::size_t*>(&range.read), true};
+    }
+};
+
+//-----------------------------------------------------------------------------
+void testRunLength(void)
+{
+    std::vector<int> v(4096, 0);
+    v.push_back(7);
+    v.insert(v.end(), 1023, 0);
+    COMPARE(mtl::run_length(4) << v, "[ 0 x4096 7 0 x1023 ]");
+    std::list<double> l = {1.0, 1.0, 1.0, 2.0, 3.0, 3.0};
+    COMPARE(mtl::run_length(3) << l, "[ 1 x3 2 3 3 ]");
+    std::array<int, 15> arr;
+    arr.fill(12);
+    COMPARE(mtl::run_length() << arr, "( 12 x15 )");
+    COMPARE(mtl::run_length(2) << mtl::run_length(0) << arr, "( 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 )");
+
+    // std::valarray::operator== doesn't return a bool, so these runs can't be collapsed.
+    std::vector<std::valarray<int>> arrays(3, std::valarray<int>{1, 2});
+    COMPARE(arrays, "[ [ 1 2 ] [ 1 2 ] [ 1 2 ] ]");
+    COMPARE(mtl::run_length(2) << arrays, "[ [ 1 2 ] [ 1 2 ] [ 1 2 ] ]");
+    std::vector<std::vector<std::valarray<int>>> nested(2, arrays);
+    COMPARE(mtl::run_length(2) << nested, "[ [ [ 1 2 ] [ 1 2 ] [ 1 2 ] ] [ [ 1 2 ] [ 1 2 ] [ 1 2 ] ] ]");
+
+    // Finding a run reads ahead, which would consume a single pass range.
+    SinglePass<int> once{{1, 1, 1, 2, 2, 3}, 0u};
+    COMPARE(mtl::run_length(2) << once, "[ 1 1 1 2 2 3 ]");
+}
+
+//-----------------------------------------------------------------------------
+void testSummary(void)
+{
+    std::vector<double> v = {1.0, 2.0, 3.0, 4.0, 5.0};
+    COMPARE(mtl::summary(v), "{ count=5 min=1 max=5 mean=3 stddev=1.41421 nan=0 }");
+    COMPARE(mtl::summary(v, true), "{ count=5 min=1 max=5 mean=3 stddev=1.41421 nan=0 p50=3 p90=5 p99=5 }");
+    std::list<float> l = {2.0f, std::numeric_limits<float>::quiet_NaN(), 4.0f};
+    COMPARE(mtl::summary(l), "{ count=2 min=2 max=4 mean=3 stddev=1 nan=1 }");
+    std::deque<int> empty;
+    COMPARE(mtl::summary(empty), "{ count=0 nan=0 }");
+}
+
+//-----------------------------------------------------------------------------
+template<typename Formatter>
+std::string drainFormatter(Formatter formatter, std::size_t chunk)
+{
+    std::string result;
+    std::vector<char> buffer(chunk);
+    while(std::size_t n = formatter.next(buffer.data(), chunk))
+    {
+        CHECK(n <= chunk);
+        result.append(buffer.data(), n);
+    }
+    CHECK(formatter.done());
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+void testChunkedFormatter(void)
+{
+    std::map<int, std::string> m = {{1, "one"}, {22, "twenty two"}};
+    CHECK(drainFormatter(mtl::chunked(m), 1u) == "[ ( 1 one ) ( 22 twenty two ) ]");
+    CHECK(drainFormatter(mtl::chunked(m), 7u) == "[ ( 1 one ) ( 22 twenty two ) ]");
+    std::tuple<int, std::vector<double>> t(1, {1.5, 2.5});
+    CHECK(drainFormatter(mtl::chunked(t), 3u) == "( 1 [ 1.5 2.5 ] )");
+    auto keys = mtl::keys(m);
+    CHECK(drainFormatter(mtl::chunked(keys), 2u) == "[ 1 22 ]");
+    auto odd = mtl::filter(mtl::keys(m), [](int k){ return k % 2 == 1; });
+    CHECK(drainFormatter(mtl::chunked(odd), 3u) == "[ 1 ]");
+    std::vector<int> digits = {0, 1, 2, 3, 4, 5};
+    auto even = mtl::every(digits, 2);
+    CHECK(drainFormatter(mtl::chunked(even), 4u) == "[ #0:0 #2:2 #4:4 ]");
+    auto picked = mtl::sample(digits, 6u, 1u);
+    CHECK(drainFormatter(mtl::chunked(picked), 4u) == "[ #0:0 #1:1 #2:2 #3:3 #4:4 #5:5 ]");
+    std::stringstream model;
+    model << std::hex;
+    std::vector<int> v(3, 255);
+    CHECK(drainFormatter(mtl::chunked(v, model), 2u) == "[ ff ff ff ]");
+
+    // A nested element much bigger than a chunk is resumed where it stopped.
+    std::vector<std::vector<int>> big(4u, std::vector<int>(20000u));
+    std::iota(big[1].begin(), big[1].end(), 0);
+    std::stringstream oracle;
+    oracle << big;
+    CHECK(drainFormatter(mtl::chunked(big), 4096u) == oracle.str());
+    CHECK(drainFormatter(mtl::chunked(big), 5u) == oracle.str());
+    std::stringstream runs;
+    runs << mtl::run_length(3);
+    oracle.str("");
+    oracle << mtl::run_length(3) << big;
+    CHECK(drainFormatter(mtl::chunked(big, runs), 4096u) == oracle.str());
+    CHECK(drainFormatter(mtl::chunked(big, runs), 3u) == oracle.str());
+    std::list<std::array<int, 2>> arrays(5u, std::array<int, 2>{{1, 2}});
+    arrays.push_back({{3, 3}});
+    CHECK(drainFormatter(mtl::chunked(arrays, runs), 2u) == "[ ( 1 2 ) x5 ( 3 3 ) ]");
+    SinglePass<int> once{{1, 1, 1, 2}, 0u};
+    CHECK(drainFormatter(mtl::chunked(once, runs), 2u) == "[ 1 1 1 2 ]");
+    std::vector<std::string> words = {std::string(10000u, 'a'), "b"};
+    CHECK(drainFormatter(mtl::chunked(words), 64u) == "[ " + words[0] + " b ]");
+    std::vector<bool> b = {true, false, true, false};
+    std::stringstream bits;
+    bits << mtl::bitstring();
+    CHECK(drainFormatter(mtl::chunked(b, bits), 3u) == "[ 1010 ]");
+    b.clear();
+    CHECK(drainFormatter(mtl::chunked(b, bits), 3u) == "[ ]");
+}
+
+//-----------------------------------------------------------------------------
+void testLargeDequeAndNodes(void)
+{
+    std::deque<int> d;
+    std::stringstream oracle;
+    oracle << "[ ";
+    for(int i=0;i<2000;++i)
+    {
+        d.push_back(i);
+        oracle << i << ' ';
+    }
+    oracle << ']';
+    COMPARE(d, oracle.str());
+    std::queue<int> q(d);
+    COMPARE(q, oracle.str());
+    std::list<int> l(d.begin(), d.end());
+    COMPARE(l, oracle.str());
+    std::set<int> s(d.begin(), d.end());
+    COMPARE(s, oracle.str());
+
+    // Looking ahead would consume a single pass range.
+    SinglePass<int> once{{1, 2, 3, 4, 5, 6, 7, 8}, 0u};
+    COMPARE(once, "[ 1 2 3 4 5 6 7 8 ]");
+}
+
+//-----------------------------------------------------------------------------
+void testBits(void)
+{
+    std::vector<bool> v(70, false);
+    v[0] = true;
+    v[69] = true;
+    std::string oracle = "[ 1 ";
+    for(int i=0;i<68;++i)
+    {
+        oracle += "0 ";
+    }
+    oracle += "1 ]";
+    COMPARE(v, oracle);
+    COMPARE(mtl::bitstring() << v, "[ 1" + std::string(68, '0') + "1 ]");
+    // The 4088 characters of bits fill the writer's buffer right at the end of the last word.
+    std::vector<bool> ones(4088, true);
+    COMPARE(mtl::bitstring() << ones, "[ " + std::string(4088, '1') + " ]");
+    COMPARE(std::boolalpha << std::vector<bool>(2, true), "[ true true ]");
+    std::vector<bool> some = {true, false, true};
+    COMPARE(std::showpos << some, "[ +1 +0 +1 ]");
+    COMPARE(std::hex << std::showbase << some, "[ 0x1 0 0x1 ]");
+    std::bitset<4> b(0x5);
+    COMPARE(mtl::bits(b), "[ 1 0 1 0 ]");
+    COMPARE(mtl::bitstring() << mtl::bits(b), "[ 1010 ]");
+    COMPARE(std::showpos << mtl::bits(b), "[ +1 +0 +1 +0 ]");
+    std::bitset<8> runs(0xF8);
+    std::vector<bool> same = {false, false, false, true, true, true, true, true};
+    COMPARE(mtl::run_length(3) << same, "[ 0 x3 1 x5 ]");
+    COMPARE(mtl::run_length(3) << mtl::bits(runs), "[ 0 x3 1 x5 ]");
+}
+
+//-----------------------------------------------------------------------------
+void testSampleEvery(void)
+{
+    std::vector<int> v = {10, 11, 12, 13, 14};
+    std::list<int> l(v.begin(), v.end());
+    COMPARE(mtl::every(v, 2), "[ #0:10 #2:12 #4:14 ]");
+    COMPARE(mtl::every(l, 3), "[ #0:10 #3:13 ]");
+    COMPARE(mtl::every(v, 10), "[ #0:10 ]");
+    COMPARE(std::hex << mtl::every(std::vector<int>(12, 15), 11), "[ #0:f #11:f ]");
+    COMPARE(mtl::sample(v, 10), "[ #0:10 #1:11 #2:12 #3:13 #4:14 ]");
+    COMPARE(mtl::sample(l, 5), "[ #0:10 #1:11 #2:12 #3:13 #4:14 ]");
+    COMPARE(mtl::sample(v, 0), "[ ]");
+    COMPARE(mtl::run_length(2) << mtl::every(std::vector<int>(3, 1), 1), "[ #0:1 #1:1 #2:1 ]");
+    bool thrown = false;
+    try
+    {
+        mtl::every(v, 0);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // Same seed, same sample ; sorted and distinct indices.
+    std::vector<double> big(10000);
+    std::iota(big.begin(), big.end(), 0.0);
+    std::list<double> big_list(big.begin(), big.end());
+    std::stringstream first, second;
+    first << mtl::sample(big, 50, 7u);
+    second << mtl::sample(big, 50, 7u);
+    CHECK(first.str() == second.str());
+    auto view = mtl::sample(big, 50, 7u);
+    std::size_t count = 0u;
+    std::size_t previous = 0u;
+    for(auto it = begin(view);it != end(view);++it, ++count)
+    {
+        CHECK(count == 0u || (*it).index > previous);
+        CHECK((*it).element == static_cast<double>((*it).index));
+        previous = (*it).index;
+    }
+    CHECK(count == 50u);
+    auto reservoir = mtl::sample(big_list, 50, 7u);
+    count = 0u;
+    for(auto it = begin(reservoir);it != end(reservoir);++it, ++count)
+    {
+        CHECK((*it).element == static_cast<double>((*it).index));
+    }
+    CHECK(count == 50u);
+}
+
+//-----------------------------------------------------------------------------
+struct NestedToString
+{
+    friend std::ostream& operator<<(std::ostream& out, const NestedToString&)
+    {
+        return out << mtl::to_string(std::vector<int>{1, 2});
+    }
+};
+
+struct NestedToStringView
+{
+    friend std::ostream& operator<<(std::ostream& out, const NestedToStringView&)
+    {
+        return out << mtl::to_string_view(1);
+    }
+};
+
+void testToStringView(void)
+{
+    std::vector<int> v = {1, 2, 3};
+    CHECK(mtl::to_string_view(v).str() == "[ 1 2 3 ]");
+    CHECK(mtl::to_string(std::make_pair(1, 2.5)) == "( 1 2.5 )");
+    COMPARE(mtl::to_string_view(v), "[ 1 2 3 ]");
+
+    // The formatting of a model is used, and doesn't leak into the next call.
+    std::stringstream model;
+    model << std::hex << mtl::run_length(2);
+    CHECK(mtl::to_string_view(std::vector<int>(3, 255), model).str() == "[ ff x3 ]");
+    CHECK(mtl::to_string_view(std::vector<int>(3, 255)).str() == "[ 255 255 255 ]");
+
+    // Owned texts survive the next calls, views don't have to.
+    std::string owned = mtl::to_string(v);
+    std::vector<int> big(10000, 7);
+    mtl::text_view text = mtl::to_string_view(big);
+    CHECK(text.size() == 2u + 2u*big.size() + 1u);
+    CHECK(owned == "[ 1 2 3 ]");
+
+    CHECK(mtl::to_string(NestedToString{}) == "[ 1 2 ]");
+    bool thrown = false;
+    try
+    {
+        mtl::to_string_view(NestedToStringView{});
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(mtl::to_string_view(v).str() == "[ 1 2 3 ]");
+
+    // Each thread has its own buffer.
+    std::string other;
+    std::thread thread([&other](){ other = mtl::to_string(std::vector<double>{0.5}); });
+    thread.join();
+    CHECK(other == "[ 0.5 ]");
+}
+
 
 //-----------------------------------------------------------------------------
 int main()
@@ -250,5 +696,17 @@ int main()
     testMultiMap();
     testUnorderedMultiMap();
     testUnorderedMultiSet();
+    testKeysValuesViews();
+    testProjectView();
+    testFilterView();
+    testMappedArray();
+    testSmallTupleFormatting();
+    testRunLength();
+    testSummary();
+    testChunkedFormatter();
+    testLargeDequeAndNodes();
+    testBits();
+    testSampleEvery();
+    testToStringView();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,196 @@
+#include <bits/stdc++.h> // Brute force includes
+
+#include "containers_ostream.hpp"
+
+
+//-----------------------------------------------------------------------------
+// Every allocation of the program goes through these counters.
+static std::size_t allocations = 0u;
+static std::size_t allocated   = 0u;
+
+// The replacements below pair malloc() with free(), which GCC can't see through once they are inlined.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    allocated += size;
+    if (void* ptr = std::malloc(size == 0u ? 1u : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief A preallocated sink, it wraps around when full so it never allocates.
+ */
+struct FixedBuffer final : public std::streambuf
+{
+    char data[1u << 16u];
+
+    FixedBuffer(void)
+    {
+        this->setp(this->data, this->data + sizeof(this->data));
+    }
+    int_type overflow(int_type c) override
+    {
+        this->setp(this->data, this->data + sizeof(this->data));
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            this->sputc(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+};
+
+static FixedBuffer  buffer;
+static std::ostream sink(&buffer);
+static int          failures = 0;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief Prints @b c twice (warm up, then steady state) and fails if the second one allocates.
+ * @param[in] name     The name displayed in the report.
+ * @param[in] c        The container you wanna print.
+ * @param[in] elements The number of elements of @b c, to report bytes per element.
+ */
+template<typename Container>
+void checkNoAllocation(const char* name, const Container& c, std::size_t elements)
+{
+    sink << c;
+    std::size_t before_count = allocations;
+    std::size_t before_bytes = allocated;
+    sink << c;
+    std::size_t count = allocations - before_count;
+    std::size_t bytes = allocated - before_bytes;
+    if (count != 0u)
+    {
+        ++failures;
+        std::cout << "Printing " << name << " allocates " << count << " time(s), " << bytes << " bytes ("
+                  << static_cast<double>(bytes)/static_cast<double>(elements == 0u ? 1u : elements)
+                  << " bytes per element)" << std::endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const std::size_t N = 1000u;
+    std::vector<int>                  vector(N, 42);
+    std::vector<double>               vector_double(N, 0.125);
+    std::list<int>                    list(N, 1);
+    std::forward_list<int>            forward_list(N, 2);
+    std::deque<int>                   deque(N, 3);
+    std::set<int>                     set;
+    std::multiset<int>                multiset;
+    std::unordered_set<int>           unordered_set;
+    std::unordered_multiset<int>      unordered_multiset;
+    std::map<int, int>                map;
+    std::multimap<int, int>           multimap;
+    std::unordered_map<int, int>      unordered_map;
+    std::unordered_multimap<int, int> unordered_multimap;
+    std::stack<int>                   stack;
+    std::queue<int>                   queue;
+    std::priority_queue<int>          priority_queue;
+    for(std::size_t i=0u;i<N;++i)
+    {
+        int value = static_cast<int>(i);
+        set.insert(value);
+        multiset.insert(value);
+        unordered_set.insert(value);
+        unordered_multiset.insert(value);
+        map.insert(std::make_pair(value, value));
+        multimap.insert(std::make_pair(value, value));
+        unordered_map.insert(std::make_pair(value, value));
+        unordered_multimap.insert(std::make_pair(value, value));
+        stack.push(value);
+        queue.push(value);
+        priority_queue.push(value);
+    }
+    std::vector<bool>                  vector_bool(N, true);
+    std::bitset<256>                   bitset;
+    std::valarray<float>               valarray(1.5f, N);
+    std::array<int, 16>                array;
+    array.fill(7);
+    int                                c_array[16] = {0};
+    std::pair<int, double>             pair(1, 2.0);
+    std::tuple<int, float, long>       tuple(1, 2.0f, 3l);
+    array_cast<int>                    casted(vector.data(), vector.size());
+
+    checkNoAllocation("std::vector<int>", vector, N);
+    checkNoAllocation("std::vector<double>", vector_double, N);
+    checkNoAllocation("std::list", list, N);
+    checkNoAllocation("std::forward_list", forward_list, N);
+    checkNoAllocation("std::deque", deque, N);
+    checkNoAllocation("std::set", set, N);
+    checkNoAllocation("std::multiset", multiset, N);
+    checkNoAllocation("std::unordered_set", unordered_set, N);
+    checkNoAllocation("std::unordered_multiset", unordered_multiset, N);
+    checkNoAllocation("std::map", map, N);
+    checkNoAllocation("std::multimap", multimap, N);
+    checkNoAllocation("std::unordered_map", unordered_map, N);
+    checkNoAllocation("std::unordered_multimap", unordered_multimap, N);
+    checkNoAllocation("std::stack", stack, N);
+    checkNoAllocation("std::queue", queue, N);
+    checkNoAllocation("std::priority_queue", priority_queue, N);
+    checkNoAllocation("std::vector<bool>", vector_bool, N);
+    checkNoAllocation("mtl::bits", mtl::bits(bitset), bitset.size());
+    checkNoAllocation("std::valarray", valarray, N);
+    checkNoAllocation("std::array", array, array.size());
+    checkNoAllocation("C-style array", c_array, 16u);
+    checkNoAllocation("std::pair", pair, 2u);
+    checkNoAllocation("std::tuple", tuple, 3u);
+    checkNoAllocation("array_cast", casted, N);
+    checkNoAllocation("mtl::keys", mtl::keys(map), N);
+    checkNoAllocation("mtl::values", mtl::values(unordered_map), N);
+    checkNoAllocation("mtl::filter", mtl::filter(vector, [](int i){return i > 0;}), N);
+    checkNoAllocation("mtl::every", mtl::every(list, 3), N/3u);
+    checkNoAllocation("mtl::summary", mtl::summary(vector_double, true), N);
+
+    // Texts are written in a per thread buffer, which only allocates while warming up.
+    mtl::to_string_view(map);
+    std::size_t before_count = allocations;
+    mtl::to_string_view(map);
+    mtl::to_string_view(vector);
+    mtl::to_string_view(tuple);
+    if (allocations != before_count)
+    {
+        ++failures;
+        std::cout << "mtl::to_string_view allocates " << allocations - before_count << " time(s)" << std::endl;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}